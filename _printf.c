@@ -3,6 +3,7 @@
 void clean(va_list ap, buffer_t *output);
 int run(const char *format, va_list ap, buffer_t *output);
 int _printf(const char *format, ...);
+int _vprintf(const char *format, va_list ap);
 
 /**
  * clean - cleans _printf
@@ -13,7 +14,8 @@ int _printf(const char *format, ...);
 void clean(va_list ap, buffer_t *output)
 {
 	va_end(ap);
-	write(1, output->start, output->len);
+	_record(output);
+	_close(output);
 	free_buffer(output);
 }
 
@@ -28,7 +30,7 @@ void clean(va_list ap, buffer_t *output)
 
 int run(const char *format, va_list ap, buffer_t *output)
 {
-	int i, ret  = 0, width, precision;
+	int i, ret  = 0, width, precision, span;
 	char temp;
 	unsigned char flags, len;
 	unsigned int (*f)(va_list, buffer_t *,
@@ -42,9 +44,14 @@ int run(const char *format, va_list ap, buffer_t *output)
 			temp = 0;
 			flags = _flag(format + i + 1, &temp);
 			width = _width(ap, format + i + temp + 1, &temp);
+			flags |= (width < 0) ? NEG : 0;
+			width = (width < 0) ? -width : width;
 			precision = _precision(ap, format + i + temp + 1, &temp);
 			len = _length(format + i + temp + 1, &temp);
 			f = _specifiers(format + i + temp + 1);
+			if (f != NULL && flags == 0 && width == 0 &&
+					precision == -1)
+				f = _plain(format + i + temp + 1, len, f);
 
 			if (f != NULL)
 			{
@@ -58,17 +65,18 @@ int run(const char *format, va_list ap, buffer_t *output)
 				break;
 			}
 		}
-		ret += _memcpy(output, (format + i), 1);
+		span = (*(format + i) == '%') ? 1 : strcspn(format + i, "%");
+		ret += _memcpy(output, (format + i), span);
+		i += span - 1;
 	}
-	clean(ap, output);
 	return (ret);
 }
 
 /**
- * _printf - prints str
+ * _printf - prints str, unless _printf_limit suppresses the call
  * @format: pointer
  *
- * Return: no. of characters
+ * Return: no. of characters, 0 if suppressed
  */
 
 int _printf(const char *format, ...)
@@ -79,13 +87,43 @@ int _printf(const char *format, ...)
 
 	if (format == NULL)
 		return (-1);
-	output = init_buffer();
+	if (_limited(format))
+		return (0);
+	output = _printf_buffer();
 	if (output == NULL)
 		return (-1);
 
 	va_start(ap, format);
 
 	ret = run(format, ap, output);
+	clean(ap, output);
+
+	return (ret);
+}
+
+/**
+ * _vprintf - va_list version of _printf
+ * @format: pointer
+ * @ap: arg, left for the caller to va_end
+ *
+ * Return: no. of characters, 0 if suppressed
+ */
 
+int _vprintf(const char *format, va_list ap)
+{
+	buffer_t *output;
+	int ret;
+
+	if (format == NULL)
+		return (-1);
+	if (_limited(format))
+		return (0);
+	output = _printf_buffer();
+	if (output == NULL)
+		return (-1);
+	ret = run(format, ap, output);
+	_record(output);
+	_close(output);
+	free_buffer(output);
 	return (ret);
 }
@@ -0,0 +1,86 @@
+#include "main.h"
+
+#define ARENA_ALIGN 16
+
+arena_t *_arena(unsigned long int block);
+void *_arena_alloc(void *arena, unsigned long int size);
+void _arena_free(arena_t *arena);
+
+/**
+ * _arena - creates a bump allocator whose allocations are freed together
+ * @block: bytes per block, BUFF_SIZE * 4 if 0
+ *
+ * Return: pointer to the arena, its alloc member plugs into
+ * _asprintf_alloc, NULL on failure
+ */
+
+arena_t *_arena(unsigned long int block)
+{
+	arena_t *arena;
+
+	arena = malloc(sizeof(arena_t));
+	if (arena == NULL)
+		return (NULL);
+	arena->alloc.alloc = _arena_alloc;
+	arena->alloc.arg = arena;
+	arena->block = NULL;
+	arena->size = (block == 0) ? BUFF_SIZE * 4 : block;
+	arena->used = arena->size;
+	return (arena);
+}
+
+/**
+ * _arena_alloc - carves size bytes off the current block, starting a new
+ * one when it is full; each block begins with a link to the one before
+ * @arena: arena
+ * @size: no of bytes
+ *
+ * Return: pointer aligned to 16 bytes, NULL when out of memory
+ */
+
+void *_arena_alloc(void *arena, unsigned long int size)
+{
+	arena_t *a = arena;
+	unsigned long int bytes;
+	char *block;
+
+	size = (size + ARENA_ALIGN - 1) & ~(unsigned long int)(ARENA_ALIGN - 1);
+	if (a->used + size > a->size)
+	{
+		bytes = size + ARENA_ALIGN;
+		if (bytes < a->size)
+			bytes = a->size;
+		block = malloc(bytes);
+		if (block == NULL)
+			return (NULL);
+		*(char **)block = a->block;
+		a->block = block;
+		a->used = ARENA_ALIGN;
+		if (bytes > a->size)
+		{
+			a->used = a->size;
+			return (block + ARENA_ALIGN);
+		}
+	}
+	a->used += size;
+	return (a->block + a->used - size);
+}
+
+/**
+ * _arena_free - frees every allocation of an arena and the arena
+ * @arena: arena
+ */
+
+void _arena_free(arena_t *arena)
+{
+	char *block, *prev;
+
+	if (arena == NULL)
+		return;
+	for (block = arena->block; block != NULL; block = prev)
+	{
+		prev = *(char **)block;
+		free(block);
+	}
+	free(arena);
+}
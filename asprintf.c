@@ -0,0 +1,131 @@
+#include "main.h"
+
+int _asprintf(char **strp, const char *format, ...);
+int _vasprintf(char **strp, const char *format, va_list ap);
+int _asprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, ...);
+int _vasprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, va_list ap);
+int _drop(buffer_t *output);
+
+static const sink_t drop_sink = {_drop, NULL, NULL, NULL, 1};
+
+/**
+ * _asprintf - formats into a newly allocated string
+ * @strp: set to the string, free it with free, NULL on error
+ * @format: pointer
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+int _asprintf(char **strp, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = _vasprintf_alloc(NULL, strp, format, ap);
+	va_end(ap);
+	return (ret);
+}
+
+/**
+ * _vasprintf - va_list version of _asprintf
+ * @strp: set to the string, free it with free, NULL on error
+ * @format: pointer
+ * @ap: arg
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+int _vasprintf(char **strp, const char *format, va_list ap)
+{
+	return (_vasprintf_alloc(NULL, strp, format, ap));
+}
+
+/**
+ * _asprintf_alloc - formats into a string from a caller allocator, eg
+ * an arena so request scoped strings are freed in bulk
+ * @alloc: allocator, malloc if NULL
+ * @strp: set to the string, NULL on error
+ * @format: pointer
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+int _asprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = _vasprintf_alloc(alloc, strp, format, ap);
+	va_end(ap);
+	return (ret);
+}
+
+/**
+ * _vasprintf_alloc - formats into a stack buffer, counting what does
+ * not fit; the string is then allocated exactly once at its final size
+ * and only formatted again if it was longer than the stack buffer
+ * @alloc: allocator, malloc if NULL
+ * @strp: set to the string, NULL on error
+ * @format: pointer
+ * @ap: arg
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+int _vasprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, va_list ap)
+{
+	char stack[512];
+	buffer_t output;
+	va_list copy;
+	int ret;
+
+	if (strp == NULL)
+		return (-1);
+	*strp = NULL;
+	if (format == NULL)
+		return (-1);
+	memset(&output, 0, sizeof(output));
+	output.buffer = output.start = stack;
+	output.size = sizeof(stack);
+	output.sink = &drop_sink;
+	va_copy(copy, ap);
+	ret = run(format, copy, &output);
+	va_end(copy);
+	if (ret >= 0)
+		*strp = (alloc == NULL) ? malloc(ret + 1) :
+			alloc->alloc(alloc->arg, ret + 1);
+	if (*strp == NULL)
+		return (-1);
+	if (output.flushes == 0)
+		memcpy(*strp, stack, ret);
+	else
+	{
+		output.buffer = output.start = *strp;
+		output.len = 0;
+		output.size = ret + 1;
+		run(format, ap, &output);
+	}
+	(*strp)[ret] = '\0';
+	return (ret);
+}
+
+/**
+ * _drop - counts a full buffer and drops its bytes
+ * @output: struct
+ *
+ * Return: 0
+ */
+
+int _drop(buffer_t *output)
+{
+	output->flushes++;
+	output->buffer = output->start;
+	output->len = 0;
+	return (0);
+}
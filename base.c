@@ -1,88 +1,89 @@
 #include "main.h"
 
-unsigned int _sbase(buffer_t *output, long int num, char *base,
-		unsigned char flag, int width, int precision);
-unsigned int _ubase(buffer_t *output, unsigned long int num,
-		char *base, unsigned char flag, int width, int precision);
+unsigned int _digits(char *dst, unsigned long int num, char spec);
+unsigned int _fill(buffer_t *output, char c, int count);
+unsigned int _vnum(buffer_t *output, const char *digits, int n,
+		const char *lead, unsigned char flag, int width, int precision);
 
 /**
-* _sbase - convert signed long to input base
-* @output: struct
-* @num: signed long to be convert
-* @base: pointer
-* @flag: flag
-* @width: width
-* @precision: precision
-* Return: noof bytes stored to buffer
+* _digits - writes num in the base of its specifier, right aligned
+* @dst: 64 bytes, the digits end at dst + 64
+* @num: value
+* @spec: d, i, u (10), o (8), x (16), X (16, upper case) or b (2, by
+* bytes with _bits)
+* Return: no of digits, at least 1
 */
-unsigned int _sbase(buffer_t *output, long int num, char *base,
-		unsigned char flag, int width, int precision)
+unsigned int _digits(char *dst, unsigned long int num, char spec)
 {
-	int size;
-	char dig;
-	char pad = '0';
-	unsigned int ret = 1;
+	const char *base = (spec == 'X') ? "0123456789ABCDEF" :
+		"0123456789abcdef";
+	unsigned int shift, n = 0;
 
-	for (size = 0; *(base + size);)
-		size++;
-	if (num >= size || num <= -size)
-		ret += _sbase(output, num / size, base, flag, width - 1, precision - 1);
-	else
+	if (spec == 'b')
 	{
-		for (; precision > 1; precision--, width--)
-			ret += _memcpy(output, &pad, 1);
-		if (NEG_FLAG == 0)
-		{
-			pad = (ZERO_FLAG == 1) ? '0' : ' ';
-			for (; width > 1; width--)
-				ret += _memcpy(output, &pad, 1);
-		}
+		n = 64 - __builtin_clzl(num | 1);
+		return (_bits(dst + 64 - n, num, n));
 	}
-	dig = base[(num < 0 ? -1 : 1) * (num % size)];
-	_memcpy(output, &dig, 1);
+	if (spec != 'o' && spec != 'x' && spec != 'X')
+		return (_utoa(dst + 44, num));
+	shift = (spec == 'o') ? 3 : 4;
+	do {
+		dst[63 - n++] = base[num & ((1UL << shift) - 1)];
+		num >>= shift;
+	} while (num != 0);
+	return (n);
+}
+
+/**
+* _fill - stores count copies of a pad char
+* @output: struct
+* @c: ' ' or '0'
+* @count: no of chars, nothing if not positive
+* Return: no of bytes stored to buffer
+*/
+unsigned int _fill(buffer_t *output, char c, int count)
+{
+	static const char spaces[] = "                                ";
+	static const char zeros[] = "00000000000000000000000000000000";
+	unsigned int ret = 0;
+
+	for (; count > 0; count -= 32)
+		ret += _memcpy(output, (c == '0') ? zeros : spaces,
+				(count < 32) ? count : 32);
 	return (ret);
 }
 
 /**
-* _ubase - convert unsigned long to input base
+* _vnum - stores a converted number laid out as printf does: padding,
+* then the sign or 0x lead, the zeros of the precision and the digits;
+* the 0 flag pads with zeros after the lead unless - or a precision is set
 * @output: struct
-* @num: long to be converted
-* @base: pointer
+* @digits: the digits
+* @n: no of digits, 0 for a zero printed with precision 0
+* @lead: sign or prefix, "" if none
 * @flag: flag
 * @width: width
-* @precision: prec
-* Return: no of bytes stored
+* @precision: min no of digits, -1 if none
+* Return: no of bytes stored to buffer
 */
-unsigned int _ubase(buffer_t *output, unsigned long int num, char *base,
-		unsigned char flag, int width, int precision)
+unsigned int _vnum(buffer_t *output, const char *digits, int n,
+		const char *lead, unsigned char flag, int width, int precision)
 {
-	unsigned int size, ret = 1;
-	char dig, pad = '0', *lead = "0x";
+	int k = strlen(lead), zeros, pad;
+	unsigned int ret;
 
-	for (size = 0; *(base + size);)
-		size++;
-	if (num >= size)
-		ret += _ubase(output, num / size, base, flag, width - 1,
-				precision - 1);
-	else
+	zeros = (precision > n) ? precision - n : 0;
+	pad = width - k - zeros - n;
+	pad = (pad > 0) ? pad : 0;
+	if (ZERO_FLAG == 1 && NEG_FLAG == 0 && precision == -1)
 	{
-		if (((flag >> 5) & 1) == 1)
-		{
-			width -= 2;
-			precision -= 2;
-		}
-		for (; precision > 1; precision--, width--)
-			ret += _memcpy(output, &pad, 1);
-		if (NEG_FLAG == 0)
-		{
-			pad = (ZERO_FLAG == 1) ? '0' : ' ';
-			for (; width > 1; width--)
-				ret += _memcpy(output, &pad, 1);
-		}
-		if (((flag >> 5) & 1) == 1)
-			ret += _memcpy(output, lead, 2);
+		zeros += pad;
+		pad = 0;
 	}
-	dig = base[(num % size)];
-	_memcpy(output, &dig, 1);
+	ret = (NEG_FLAG == 0) ? _fill(output, ' ', pad) : 0;
+	ret += _memcpy(output, lead, k);
+	ret += _fill(output, '0', zeros);
+	ret += _memcpy(output, digits, n);
+	ret += (NEG_FLAG == 1) ? _fill(output, ' ', pad) : 0;
 	return (ret);
 }
@@ -0,0 +1,210 @@
+#include "main.h"
+
+fmt_op_t *_printf_compile(const char *format);
+int _compile_spec(fmt_op_t *op, const char *format, ...);
+long int _printf_batch(const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe);
+long int _ctx_batch(printf_ctx_t *ctx, const fmt_op_t *ops,
+		const void *records, unsigned long int count,
+		unsigned long int stride, const unsigned long int *describe);
+unsigned int _batch_field(buffer_t *output, const fmt_op_t *op,
+		const char *field);
+
+/* 1 if the batch renderers can store a compiled directive */
+#define BATCH_SPEC(op) ((op).spec != 0 && \
+	strchr("csdiuoxXbjJBD%", (op).spec) != NULL && \
+	((op).len != LONG || strchr("cs", (op).spec) == NULL))
+
+/**
+ * _printf_compile - parses a format once into literal runs and
+ * directives; format must outlive the ops, which point into it
+ * @format: %c %s %d %i %u %o %x %X %b %j %J %B %D and %% with flags, width,
+ * precision and h or l, but no * and no %lc or %ls
+ *
+ * Return: ops ending with spec 0, free them with free, NULL on error
+ */
+
+fmt_op_t *_printf_compile(const char *format)
+{
+	fmt_op_t *ops;
+	const char *p, *text;
+	unsigned int n = 1, k = 0, m;
+
+	if (format == NULL)
+		return (NULL);
+	for (p = format; *p; p++)
+		n += (*p == '%');
+	ops = malloc(sizeof(fmt_op_t) * n);
+	if (ops == NULL)
+		return (NULL);
+	for (text = p = format; ; text = p, k++)
+	{
+		p += strcspn(p, "%");
+		ops[k].text = text;
+		ops[k].n = p - text;
+		ops[k].spec = 0;
+		if (*p == '\0')
+			return (ops);
+		m = strspn(p + 1, "+- #'0123456789.*hl");
+		if (memchr(p + 1, '*', m) != NULL)
+			break;
+		p += 1 + _compile_spec(&ops[k], p + 1);
+		if (!BATCH_SPEC(ops[k]))
+			break;
+	}
+	free(ops);
+	return (NULL);
+}
+
+/**
+ * _compile_spec - parses one directive the way run does; variadic only
+ * to hand _width and _precision a va_list they never read
+ * @op: filled in
+ * @format: pointer past the %
+ *
+ * Return: no of chars parsed
+ */
+
+int _compile_spec(fmt_op_t *op, const char *format, ...)
+{
+	va_list ap;
+	char i = 0;
+
+	va_start(ap, format);
+	op->flag = _flag(format, &i);
+	op->width = _width(ap, format + i, &i);
+	op->precision = _precision(ap, format + i, &i);
+	op->len = _length(format + i, &i);
+	va_end(ap);
+	op->spec = format[(int)i];
+	return (i + 1);
+}
+
+/**
+ * _printf_batch - prints count records with one format through a single
+ * buffered stdout sink, parsing the format once
+ * @format: format, see _printf_compile
+ * @records: array of records
+ * @count: no of records
+ * @stride: bytes from one record to the next, usually sizeof a record
+ * @describe: offset in the record of the field of each directive but %%,
+ * read as the type the directive takes (char * for %s, %j and %J)
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+long int _printf_batch(const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe)
+{
+	printf_ctx_t *ctx = NULL;
+	fmt_op_t *ops;
+	long int ret = -1;
+
+	ops = _printf_compile(format);
+	if (ops != NULL)
+		ctx = _ctx_open(1, BUFF_SIZE * 64);
+	if (ctx != NULL)
+	{
+		ret = _ctx_batch(ctx, ops, records, count, stride, describe);
+		if (_ctx_close(ctx) < 0)
+			ret = -1;
+	}
+	free(ops);
+	return (ret);
+}
+
+/**
+ * _ctx_batch - formats count records with compiled ops into a context,
+ * the batch is committed to the sink as one record
+ * @ctx: context
+ * @ops: from _printf_compile
+ * @records: array of records
+ * @count: no of records
+ * @stride: bytes from one record to the next
+ * @describe: field offset of each directive but %%
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+long int _ctx_batch(printf_ctx_t *ctx, const fmt_op_t *ops,
+		const void *records, unsigned long int count,
+		unsigned long int stride, const unsigned long int *describe)
+{
+	const char *record = records;
+	const fmt_op_t *op;
+	const char *field;
+	unsigned long int r, f;
+	long int ret = 0;
+
+	if (ctx == NULL || ops == NULL || (count > 0 && records == NULL))
+		return (-1);
+	for (r = 0; r < count; r++, record += stride)
+	{
+		for (op = ops, f = 0; op->spec != 0; op++)
+		{
+			ret += _memcpy(ctx->output, op->text, op->n);
+			field = (op->spec == '%') ? NULL :
+				record + describe[f++];
+			ret += _batch_field(ctx->output, op, field);
+		}
+		ret += _memcpy(ctx->output, op->text, op->n);
+	}
+	_record(ctx->output);
+	ctx->calls++;
+	ctx->bytes += ret;
+	return (ret);
+}
+
+/**
+ * _batch_field - reads a directive's field from a record and stores it
+ * @output: struct
+ * @op: directive
+ * @field: pointer to the field, NULL for %%
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _batch_field(buffer_t *output, const fmt_op_t *op,
+		const char *field)
+{
+	char s = op->spec;
+	long int d;
+	unsigned long int u;
+	unsigned char flag = op->flag;
+	int w = op->width, p = op->precision;
+
+	if (s == '%')
+		return (_vchar(output, '%', flag, w));
+	if (s == 'c')
+		return (_vchar(output, *field, flag, w));
+	if (s == 's')
+		return (_vstr(output, *(char *const *)field, flag, w, p));
+	if (s == 'j' || s == 'J')
+		return (_vjson(output, *(char *const *)field, s, p));
+	if (s == 'd' || s == 'i' || s == 'D')
+	{
+		d = (op->len == LONG) ? *(const long int *)field :
+			(op->len == SHORT) ? *(const short *)field :
+			(op->len == CHAR) ? *(const signed char *)field :
+			*(const int *)field;
+		if (s == 'D')
+			return (_vdur(output, d, flag, w, p));
+		if (p != -1 || (PLUS_FLAG && SPACE_FLAG) || GROUP_FLAG)
+			return (_vint(output, d, flag, w, p));
+		return (_vdec(output, d, s, flag, w));
+	}
+	u = (op->len == LONG) ? *(const unsigned long int *)field :
+		(op->len == SHORT) ? *(const unsigned short *)field :
+		(op->len == CHAR) ? *(const unsigned char *)field :
+		*(const unsigned int *)field;
+	if (s == 'B')
+		return (_vbytes(output, u, flag, w, p));
+	if (s == 'u' && p == -1 && !GROUP_FLAG)
+		return (_vdec(output, u, s, flag, w));
+	if ((s == 'x' || s == 'X') && (flag | w) == 0 && p == -1)
+		return (_khex(output, u, (s == 'x') ? "0123456789abcdef" :
+					"0123456789ABCDEF"));
+	return (_vuint(output, u, s, flag, w, p));
+}
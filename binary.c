@@ -0,0 +1,149 @@
+#include "main.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+int _printf_bin_group(int bits);
+unsigned long int _bit_chars(unsigned int byte);
+unsigned int _bits(char *dst, unsigned long int num, unsigned int n);
+unsigned int _bin_group(char *dst, unsigned long int num, int n,
+		int precision);
+unsigned int _vbin(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision);
+
+static int group_bits = 4;
+
+/**
+ * _printf_bin_group - selects how many bits the ' flag groups %b in
+ * @bits: 4 for nibbles or 8 for bytes, -1 to only query
+ *
+ * Return: the previous group size
+ */
+
+int _printf_bin_group(int bits)
+{
+	int prev = __atomic_load_n(&group_bits, __ATOMIC_RELAXED);
+
+	if (bits == 4 || bits == 8)
+		__atomic_store_n(&group_bits, bits, __ATOMIC_RELAXED);
+	return (prev);
+}
+
+/**
+ * _bit_chars - expands a byte into its 8 binary digits in one word, most
+ * significant first in memory, without a branch: pdep with BMI2, else
+ * one multiply spreads bit i to the top of byte 7 - i
+ * @byte: value below 256
+ *
+ * Return: the digits, to be stored with one 8 byte copy
+ */
+
+unsigned long int _bit_chars(unsigned int byte)
+{
+	unsigned long int w;
+
+#if defined(__BMI2__)
+	w = __builtin_bswap64(_pdep_u64(byte, 0x0101010101010101UL));
+#else
+	w = ((byte * 0x8040201008040201UL) & 0x8080808080808080UL) >> 7;
+#endif
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	w = __builtin_bswap64(w);
+#endif
+	return (w + 0x3030303030303030UL);
+}
+
+/**
+ * _bits - writes the low n bits of num as binary digits, a byte at a
+ * time
+ * @dst: n bytes
+ * @num: value
+ * @n: no of digits, at most 64
+ *
+ * Return: n
+ */
+
+unsigned int _bits(char *dst, unsigned long int num, unsigned int n)
+{
+	unsigned long int w;
+	unsigned int k = n % 8;
+
+	if (k != 0)
+	{
+		w = _bit_chars((num >> (n - k)) & 255);
+		memcpy(dst, (char *)&w + 8 - k, k);
+	}
+	for (; k < n; k += 8)
+	{
+		w = _bit_chars((num >> (n - k - 8)) & 255);
+		memcpy(dst + k, &w, 8);
+	}
+	return (n);
+}
+
+/**
+ * _bin_group - writes binary digits with a _ between groups of bits,
+ * zeros from the precision included, up to 64 digits
+ * @dst: 80 bytes
+ * @num: value
+ * @n: no of significant digits
+ * @precision: min no of digits, -1 if none
+ *
+ * Return: no of bytes written
+ */
+
+unsigned int _bin_group(char *dst, unsigned long int num, int n,
+		int precision)
+{
+	int g = __atomic_load_n(&group_bits, __ATOMIC_RELAXED);
+	int m = (precision > n) ? precision : n, i, k = 0;
+	char digits[64];
+
+	m = (m > 64) ? 64 : m;
+	_bits(digits, num, m);
+	for (i = 0; i < m; i++)
+	{
+		dst[k++] = digits[i];
+		if ((m - 1 - i) % g == 0 && i + 1 < m)
+			dst[k++] = '_';
+	}
+	return (k);
+}
+
+/**
+ * _vbin - stores a value in binary (%b), written straight into the
+ * buffer when there is no flag, width or precision
+ * @output: struct
+ * @num: value
+ * @flag: flag, # leads with 0b, ' groups the digits
+ * @width: width
+ * @precision: min no of digits, -1 if none
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _vbin(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision)
+{
+	char text[80], *dst;
+	const char *lead = (HASH_FLAG == 1 && num != 0) ? "0b" : "";
+	unsigned int n = 64 - __builtin_clzl(num | 1), got;
+
+	n = (num == 0 && precision == 0) ? 0 : n;
+	if ((flag | width) == 0 && precision == -1)
+	{
+		got = n;
+		dst = _reserve(output, &got);
+		if (got == n)
+			return (_commit(output, _bits(dst, num, n)));
+	}
+	if (GROUP_FLAG == 1)
+	{
+		got = _bin_group(text, num, n, precision);
+		precision = (precision > 64) ? (int)got + precision - 64 : -1;
+		return (_vnum(output, text, got, lead, flag, width, precision));
+	}
+	return (_vnum(output, text, _bits(text, num, n), lead, flag, width,
+				precision));
+}
@@ -0,0 +1,195 @@
+#include "main.h"
+#include <errno.h>
+#include <sys/uio.h>
+
+buffer_t *_co_buffer(int fd, unsigned int size, coalesce_t *co);
+int _co_commit(buffer_t *output);
+int _co_flush(buffer_t *output);
+int _co_close(buffer_t *output);
+int _co_write(buffer_t *output, int summary);
+
+static const sink_t co_sink = {_co_flush, _co_commit, _co_flush, _co_close,
+	0};
+
+/**
+ * _co_buffer - buffer over a descriptor whose sink drops a record equal
+ * to the one before it, counting it for a "last message repeated" line
+ * @fd: file descriptor
+ * @size: capacity
+ * @co: state, shared by the short lived buffers of _printf or owned
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_co_buffer(int fd, unsigned int size, coalesce_t *co)
+{
+	char *start = _pool_get(size);
+	buffer_t *output;
+
+	output = (start == NULL) ? NULL : _buffer(start, size, &co_sink, co);
+	if (output == NULL)
+	{
+		_pool_put(start, size);
+		return (NULL);
+	}
+	output->fd = fd;
+	return (output);
+}
+
+/**
+ * _co_commit - ends a record: drops it if it equals the last one, hash
+ * first then memcmp, otherwise reports the repeats before it and keeps
+ * it as the last one; shared state writes the record out at once
+ * @output: struct
+ *
+ * Return: 0, -1 on a write error
+ */
+
+int _co_commit(buffer_t *output)
+{
+	coalesce_t *co = output->data;
+	char *rec = output->start + co->mark;
+	unsigned int n = output->len - co->mark;
+	unsigned long int h = _co_hash(rec, n);
+	int ret = 0;
+
+	if (co->shared)
+		pthread_mutex_lock(&co->lock);
+	if (output->flushes == co->at && (int)n == co->n && h == co->hash &&
+			memcmp(rec, co->last, n) == 0)
+	{
+		co->repeats++;
+		output->len = co->mark;
+		output->buffer = rec;
+	}
+	else
+	{
+		co->n = (n <= COALESCE_MAX && output->flushes == co->at) ?
+			(int)n : -1;
+		if (co->n >= 0)
+			memcpy(co->last, rec, n);
+		co->hash = h;
+		if (co->repeats > 0)
+			ret = _co_write(output, 1);
+	}
+	if (co->shared && ret == 0)
+		ret = _co_write(output, 0);
+	co->mark = output->len;
+	co->at = co->shared ? 0 : output->flushes;
+	if (co->shared)
+		pthread_mutex_unlock(&co->lock);
+	return (ret);
+}
+
+/**
+ * _co_flush - writes out the buffer when it is full or on a flush, with
+ * the repeats counted so far reported in their place; a record in
+ * progress behind committed ones is kept, moved to the front, so it can
+ * still be compared
+ * @output: struct
+ *
+ * Return: 0, -1 on a write error
+ */
+
+int _co_flush(buffer_t *output)
+{
+	coalesce_t *co = output->data;
+	unsigned int mark = co->mark, part = output->len - co->mark;
+	int ret;
+
+	if (co->shared)
+		pthread_mutex_lock(&co->lock);
+	if (mark == 0 || part == 0)
+		ret = _co_write(output, 1);
+	else
+	{
+		output->len = mark;
+		ret = _co_write(output, 0);
+		memmove(output->start, output->start + mark, part);
+		output->len = part;
+		output->buffer = output->start + part;
+		co->at = output->flushes;
+	}
+	if (co->shared)
+		pthread_mutex_unlock(&co->lock);
+	return (ret);
+}
+
+/**
+ * _co_close - final write; owned state reports its repeats and is freed,
+ * shared state keeps counting across _printf calls
+ * @output: struct
+ *
+ * Return: 0, -1 on a write error
+ */
+
+int _co_close(buffer_t *output)
+{
+	coalesce_t *co = output->data;
+	int ret;
+
+	if (co->shared)
+	{
+		pthread_mutex_lock(&co->lock);
+		ret = _co_write(output, 0);
+		pthread_mutex_unlock(&co->lock);
+		return (ret);
+	}
+	ret = _co_write(output, 1);
+	_pool_put(co, sizeof(coalesce_t));
+	output->data = NULL;
+	return (ret);
+}
+
+/**
+ * _co_write - writes the committed records, the repeat line if asked
+ * and there are repeats, then the record in progress, in one writev
+ * @output: struct
+ * @summary: 1 to report the repeats
+ *
+ * Return: 0, -1 on a write error
+ */
+
+int _co_write(buffer_t *output, int summary)
+{
+	coalesce_t *co = output->data;
+	char text[64];
+	struct iovec iov[3];
+	unsigned int k = 0, t = 0;
+	ssize_t n;
+
+	if (summary && co->repeats > 0)
+	{
+		t = _utoa(text + 22, co->repeats);
+		memmove(text + 22, text + 42 - t, t);
+		memcpy(text, "last message repeated ", 22);
+		memcpy(text + 22 + t, " times\n", 7);
+		t += 29;
+		co->repeats = 0;
+	}
+	iov[0].iov_base = output->start;
+	iov[0].iov_len = co->mark;
+	iov[1].iov_base = text;
+	iov[1].iov_len = t;
+	iov[2].iov_base = output->start + co->mark;
+	iov[2].iov_len = output->len - co->mark;
+	while (k < 3 && output->error == 0)
+	{
+		n = (iov[k].iov_len == 0) ? 0 :
+			writev(output->fd, iov + k, 3 - k);
+		if (n < 0 && errno == EINTR)
+			continue;
+		output->error = (n < 0 || (n == 0 && iov[k].iov_len > 0));
+		for (; k < 3 && (size_t)n >= iov[k].iov_len; k++)
+			n -= iov[k].iov_len;
+		if (k < 3 && n > 0)
+			iov[k].iov_base = (char *)iov[k].iov_base + n;
+		if (k < 3 && n > 0)
+			iov[k].iov_len -= n;
+	}
+	output->flushes += (output->len + t > 0);
+	output->len = 0;
+	output->buffer = output->start;
+	co->mark = 0;
+	return (output->error ? -1 : 0);
+}
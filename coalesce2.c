@@ -0,0 +1,118 @@
+#include "main.h"
+
+buffer_t *_sink_coalesce(int fd, unsigned int size);
+int _printf_coalesce(int on);
+buffer_t *_printf_buffer(void);
+void _co_exit(void);
+unsigned long int _co_hash(const char *s, unsigned int n);
+
+static coalesce_t out = {PTHREAD_MUTEX_INITIALIZER, 1, 0, 0, 0, -1, 0, {0}};
+static int coalescing, registered;
+
+/**
+ * _sink_coalesce - buffer over a descriptor that collapses a run of equal
+ * records (calls) into the first one and a "last message repeated N
+ * times" line, written once a different record comes or on flush
+ * @fd: file descriptor
+ * @size: capacity, BUFF_SIZE if 0
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_coalesce(int fd, unsigned int size)
+{
+	coalesce_t *co = _pool_get(sizeof(coalesce_t));
+	buffer_t *output;
+
+	if (co == NULL)
+		return (NULL);
+	memset(co, 0, sizeof(coalesce_t));
+	co->n = -1;
+	output = _co_buffer(fd, (size == 0) ? BUFF_SIZE : size, co);
+	if (output == NULL)
+		_pool_put(co, sizeof(coalesce_t));
+	return (output);
+}
+
+/**
+ * _printf_coalesce - turns coalescing of repeated _printf lines on or
+ * off; turning it off, or exiting, writes the pending repeat line
+ * @on: 1 for on, 0 for off, -1 to only query
+ *
+ * Return: the previous setting
+ */
+
+int _printf_coalesce(int on)
+{
+	int prev = __atomic_load_n(&coalescing, __ATOMIC_RELAXED);
+
+	if (on == 1 && !__atomic_exchange_n(&registered, 1, __ATOMIC_RELAXED))
+		atexit(_co_exit);
+	if (on == 0)
+		_co_exit();
+	if (on == 0 || on == 1)
+		__atomic_store_n(&coalescing, on, __ATOMIC_RELAXED);
+	return (prev);
+}
+
+/**
+ * _printf_buffer - buffer of one _printf call: plain stdout, one over
+ * the coalescing state all _printf calls share, or one handing its bytes
+ * to the _printf_buffered buffer; coalescing comes first
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_printf_buffer(void)
+{
+	if (__atomic_load_n(&coalescing, __ATOMIC_RELAXED) != 0)
+		return (_co_buffer(1, BUFF_SIZE, &out));
+	if (_printf_buffered(-1) > 0)
+		return (_dl_buffer());
+	return (init_buffer(1, BUFF_SIZE));
+}
+
+/**
+ * _co_exit - writes the repeat line _printf calls still have pending and
+ * forgets the last record, lines printed while off must not match it
+ */
+
+void _co_exit(void)
+{
+	buffer_t none;
+	char empty[1];
+
+	memset(&none, 0, sizeof(none));
+	none.start = none.buffer = empty;
+	none.fd = 1;
+	none.data = &out;
+	pthread_mutex_lock(&out.lock);
+	_co_write(&none, 1);
+	out.n = -1;
+	pthread_mutex_unlock(&out.lock);
+}
+
+/**
+ * _co_hash - hashes a record a word at a time, to rule out most
+ * mismatches before the memcmp
+ * @s: record
+ * @n: no of bytes
+ *
+ * Return: hash
+ */
+
+unsigned long int _co_hash(const char *s, unsigned int n)
+{
+	unsigned long int h = 0xcbf29ce484222325UL ^ n, w;
+	unsigned int i;
+
+	for (i = 0; i + sizeof(w) <= n; i += sizeof(w))
+	{
+		memcpy(&w, s + i, sizeof(w));
+		h = (h ^ w) * 0x100000001b3UL;
+		h ^= h >> 29;
+	}
+	for (; i < n; i++)
+		h = (h ^ (unsigned char)s[i]) * 0x100000001b3UL;
+	return (h);
+}
@@ -0,0 +1,140 @@
+#include "main.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+/* 1 if none of the 16 bytes at p has its top bit set */
+#define ASCII16(p) (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(p))) \
+	== 0)
+#endif
+
+int _printf_width_mode(int mode);
+unsigned int _ucols(unsigned long int cp);
+unsigned int _udecode(const char *str, unsigned int n, unsigned long int *cp);
+unsigned int _measure(const char *str, unsigned int max, int width);
+
+static int width_mode = WIDTH_BYTES;
+
+/**
+ * _printf_width_mode - selects what string widths are counted in
+ * @mode: WIDTH_BYTES, WIDTH_POINTS or WIDTH_COLUMNS, -1 to only query
+ *
+ * Return: the previous mode
+ */
+int _printf_width_mode(int mode)
+{
+	int prev = width_mode;
+
+	if (mode >= WIDTH_BYTES && mode <= WIDTH_COLUMNS)
+		width_mode = mode;
+	return (prev);
+}
+
+/**
+ * _ucols - display columns of a code point, locale free
+ * @cp: code point
+ *
+ * Return: 0 for combining marks, 2 for east asian wide, else 1
+ */
+unsigned int _ucols(unsigned long int cp)
+{
+	static const unsigned long int range[][3] = {
+		{0x0300, 0x036f, 0}, {0x1100, 0x115f, 2}, {0x1ab0, 0x1aff, 0},
+		{0x1dc0, 0x1dff, 0}, {0x200b, 0x200f, 0}, {0x20d0, 0x20ff, 0},
+		{0x2e80, 0x303e, 2}, {0x3041, 0x33ff, 2}, {0x3400, 0x4dbf, 2},
+		{0x4e00, 0x9fff, 2}, {0xa000, 0xa4cf, 2}, {0xac00, 0xd7a3, 2},
+		{0xf900, 0xfaff, 2}, {0xfe00, 0xfe0f, 0}, {0xfe20, 0xfe2f, 0},
+		{0xfe30, 0xfe4f, 2}, {0xff00, 0xff60, 2}, {0xffe0, 0xffe6, 2},
+		{0x1f300, 0x1f64f, 2}, {0x1f900, 0x1f9ff, 2},
+		{0x20000, 0x2fffd, 2}, {0x30000, 0x3fffd, 2}
+	};
+	int lo = 0, hi = sizeof(range) / sizeof(range[0]) - 1, mid;
+
+	if (cp < 0x300)
+		return (1);
+	while (lo <= hi)
+	{
+		mid = (lo + hi) / 2;
+		if (cp < range[mid][0])
+			hi = mid - 1;
+		else if (cp > range[mid][1])
+			lo = mid + 1;
+		else
+			return (range[mid][2]);
+	}
+	return (1);
+}
+
+/**
+ * _udecode - decodes one utf-8 sequence
+ * @str: pointer to a lead byte >= 0x80
+ * @n: bytes available
+ * @cp: decoded code point, the byte itself if malformed
+ *
+ * Return: no of bytes consumed, 1 if malformed
+ */
+unsigned int _udecode(const char *str, unsigned int n, unsigned long int *cp)
+{
+	const unsigned char *s = (const unsigned char *)str;
+	unsigned int i, size;
+
+	*cp = s[0];
+	if (s[0] >= 0xf0 && s[0] < 0xf5)
+		size = 4;
+	else if (s[0] >= 0xe0)
+		size = (s[0] < 0xf0) ? 3 : 1;
+	else
+		size = (s[0] >= 0xc2) ? 2 : 1;
+	if (size == 1 || size > n)
+		return (1);
+	for (i = 1; i < size; i++)
+		if ((s[i] & 0xc0) != 0x80)
+			return (1);
+	*cp = s[0] & (0x7f >> size);
+	for (i = 1; i < size; i++)
+		*cp = (*cp << 6) | (s[i] & 0x3f);
+	return (size);
+}
+
+/**
+ * _measure - size of at most max bytes of a string in the width mode,
+ * counting stops once width is reached
+ * @str: string
+ * @max: cap on the no of bytes, ie the precision
+ * @width: width
+ *
+ * Return: size in bytes, code points or columns
+ */
+unsigned int _measure(const char *str, unsigned int max, int width)
+{
+	unsigned int i, end, size = 0, stop = (width > 0) ? width : 0;
+	unsigned long int cp;
+
+	if (width_mode == WIDTH_BYTES)
+		return (strnlen(str, stop < max ? stop : max));
+	for (i = 0; i < max && size < stop; )
+	{
+		end = i + strnlen(str + i, (max - i < 256) ? max - i : 256);
+		if (end == i)
+			break;
+		while (i < end && size < stop)
+		{
+#if defined(__SSE2__)
+			if (end - i >= 16 && ASCII16(str + i))
+			{
+				size += 16;
+				i += 16;
+				continue;
+			}
+#endif
+			if ((unsigned char)str[i] < 0x80)
+			{
+				size++;
+				i++;
+				continue;
+			}
+			i += _udecode(str + i, max - i, &cp);
+			size += (width_mode == WIDTH_POINTS) ? 1 : _ucols(cp);
+		}
+	}
+	return (size);
+}
@@ -0,0 +1,95 @@
+#include "main.h"
+
+printf_ctx_t *_ctx_open(int fd, unsigned int capacity);
+int _cprintf(printf_ctx_t *ctx, const char *format, ...);
+int _vcprintf(printf_ctx_t *ctx, const char *format, va_list ap);
+int _ctx_flush(printf_ctx_t *ctx);
+int _ctx_close(printf_ctx_t *ctx);
+
+/**
+ * _ctx_open - creates an output context whose buffer outlives calls
+ * @fd: file descriptor to write to
+ * @capacity: buffer size in bytes, BUFF_SIZE if 0
+ *
+ * Return: pointer to the context, NULL on failure
+ */
+
+printf_ctx_t *_ctx_open(int fd, unsigned int capacity)
+{
+	return (_ctx_sink(init_buffer(fd, capacity)));
+}
+
+/**
+ * _cprintf - formats into a context's buffer, writing only when full
+ * @ctx: context
+ * @format: pointer
+ *
+ * Return: no. of characters
+ */
+
+int _cprintf(printf_ctx_t *ctx, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = _vcprintf(ctx, format, ap);
+	va_end(ap);
+	return (ret);
+}
+
+/**
+ * _vcprintf - va_list version of _cprintf
+ * @ctx: context
+ * @format: pointer
+ * @ap: arg
+ *
+ * Return: no. of characters
+ */
+
+int _vcprintf(printf_ctx_t *ctx, const char *format, va_list ap)
+{
+	int ret;
+
+	if (ctx == NULL || format == NULL)
+		return (-1);
+	ret = run(format, ap, ctx->output);
+	_record(ctx->output);
+	ctx->calls++;
+	if (ret > 0)
+		ctx->bytes += ret;
+	return (ret);
+}
+
+/**
+ * _ctx_flush - hands whatever the context has buffered to its sink
+ * @ctx: context
+ *
+ * Return: no of bytes flushed, -1 on error
+ */
+
+int _ctx_flush(printf_ctx_t *ctx)
+{
+	if (ctx == NULL)
+		return (-1);
+	return (_flush(ctx->output));
+}
+
+/**
+ * _ctx_close - closes the sink and frees a context
+ * @ctx: context
+ *
+ * Return: 0, -1 if the sink failed at any point
+ */
+
+int _ctx_close(printf_ctx_t *ctx)
+{
+	int ret;
+
+	if (ctx == NULL)
+		return (-1);
+	ret = _close(ctx->output);
+	free_buffer(ctx->output);
+	_pool_put(ctx, sizeof(printf_ctx_t));
+	return (ret);
+}
@@ -0,0 +1,46 @@
+#include "main.h"
+
+printf_ctx_t *_ctx_sink(buffer_t *output);
+int _ctx_trim(printf_ctx_t *ctx);
+
+/**
+ * _ctx_sink - creates an output context over any sink's buffer
+ * @output: buffer from init_buffer or a _sink_* function, owned by the
+ * context from here on
+ *
+ * Return: pointer to the context, NULL on failure
+ */
+
+printf_ctx_t *_ctx_sink(buffer_t *output)
+{
+	printf_ctx_t *ctx;
+
+	if (output == NULL)
+		return (NULL);
+	ctx = _pool_get(sizeof(printf_ctx_t));
+	if (ctx == NULL)
+	{
+		_close(output);
+		free_buffer(output);
+		return (NULL);
+	}
+	ctx->output = output;
+	ctx->calls = 0;
+	ctx->bytes = 0;
+	return (ctx);
+}
+
+/**
+ * _ctx_trim - writes out an idle context and shrinks its buffer to the
+ * most it held since the last trim, see _trim
+ * @ctx: context from _ctx_open
+ *
+ * Return: the capacity now, -1 on error
+ */
+
+int _ctx_trim(printf_ctx_t *ctx)
+{
+	if (ctx == NULL)
+		return (-1);
+	return (_trim(ctx->output));
+}
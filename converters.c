@@ -12,7 +12,8 @@ unsigned int _bin(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len);
 
 /**
- * _char - converts tounsigned char and stores in buffer
+ * _char - converts tounsigned char and stores in buffer, %lc goes
+ * to _wchar
  * @ap: arg
  * @output: struct
  * @flag: flag
@@ -26,17 +27,9 @@ unsigned int _bin(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _char(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	char c;
-	unsigned int ret = 0;
-
-	(void)precision;
-	(void)len;
-	c = va_arg(ap, int);
-	ret += print_width(output, ret, flag, width);
-	ret += _memcpy(output, &c, 1);
-	ret += neg_width(output, ret, flag, width);
-
-	return (ret);
+	if (len == LONG)
+		return (_wchar(ap, output, flag, width, precision, len));
+	return (_vchar(output, va_arg(ap, int), flag, width));
 }
 
 /**
@@ -68,7 +61,8 @@ unsigned int _perc(va_list ap, buffer_t *output, unsigned char flag,
 }
 
 /**
- * _string - convertes arg to string and stores in buffer
+ * _string - convertes arg to string and stores in buffer, reading at
+ * most precision bytes; %ls goes to _wstring
  * @ap: arg
  * @output: buffer struct
  * @flag: flag
@@ -82,29 +76,9 @@ unsigned int _perc(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _string(va_list ap, buffer_t *output, unsigned char flag,
 		 int width, int precision, unsigned char len)
 {
-	char *str;
-	char *null = "(null)";
-	int size;
-	unsigned int ret = 0;
-
-	(void)flag;
-	(void)len;
-	str = va_arg(ap, char *);
-	if (str == NULL)
-		return (_memcpy(output, null, 6));
-
-	for (size = 0 ; *(str + size) ; )
-		size++;
-	ret += string_width(output, flag, width, precision, size);
-	precision = (precision == -1) ? size : precision;
-	while (*str != '\0')
-	{
-		ret += _memcpy(output, str, 1);
-		precision--;
-		str++;
-	}
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	if (len == LONG)
+		return (_wstring(ap, output, flag, width, precision, len));
+	return (_vstr(output, va_arg(ap, char *), flag, width, precision));
 }
 
 /**
@@ -122,9 +96,7 @@ unsigned int _string(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _int(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	long int d, copy;
-	unsigned int ret = 0, count = 0;
-	char pad, space = ' ', neg = '-', plus = '+';
+	long int d;
 
 	if (len == LONG)
 		d = va_arg(ap, long int);
@@ -132,39 +104,13 @@ unsigned int _int(va_list ap, buffer_t *output, unsigned char flag,
 		d = va_arg(ap, int);
 	if (len == SHORT)
 		d = (short)d;
-	if (SPACE_FLAG == 1 && d >= 0)
-		ret += _memcpy(output, &space, 1);
-	if (precision <= 0 && NEG_FLAG == 0)
-	{
-		if (d == LONG_MIN)
-			count += 19;
-		else
-			for (copy = (d < 0) ? -d : d; copy > 0; copy /= 10)
-				count++;
-		count += (d == 0) ? 1 : 0;
-		count += (d < 0) ? 1 : 0;
-		count += (PLUS_FLAG == 1 && d >= 0) ? 1 : 0;
-		count += (SPACE_FLAG == 1 && d >= 0) ? 1 : 0;
-		if (ZERO_FLAG == 1 && PLUS_FLAG == 1 && d >= 0)
-			ret += _memcpy(output, &plus, 1);
-		if  (ZERO_FLAG == 1 && d < 0)
-			ret += _memcpy(output, &neg, 1);
-		pad = (ZERO_FLAG == 1) ? '0' : ' ';
-		for (width -= count; width > 0; width--)
-			ret += _memcpy(output, &pad, 1);
-	}
-	if (ZERO_FLAG == 0 && d < 0)
-		ret += _memcpy(output, &neg, 1);
-	if (ZERO_FLAG == 0 && (PLUS_FLAG == 1 && d >= 0))
-		ret += _memcpy(output, &plus, 1);
-	if (!(d == 0 && precision == 0))
-		ret += _sbase(output, d, "0123456789", flag, 0, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	else if (len == CHAR)
+		d = (signed char)d;
+	return (_vint(output, d, flag, width, precision));
 }
 
 /**
-* _bin - converts unsigned int to binary
+* _bin - converts unsigned int, short or long to binary
 * @ap: arg
 * @flag: flag
 * @width: width
@@ -176,8 +122,15 @@ unsigned int _int(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _bin(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	unsigned int num = va_arg(ap, unsigned int);
+	unsigned long int num;
 
-	(void)len;
-	return (_ubase(output, num, "01", flag, width, precision));
+	if (len == LONG)
+		num = va_arg(ap, unsigned long int);
+	else
+		num = va_arg(ap, unsigned int);
+	if (len == SHORT)
+		num = (unsigned short)num;
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vbin(output, num, flag, width, precision));
 }
@@ -25,7 +25,6 @@ unsigned int _dec(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
 	unsigned long int num;
-	unsigned int ret = 0;
 
 	if (len == LONG)
 		num = va_arg(ap, unsigned long int);
@@ -33,11 +32,9 @@ unsigned int _dec(va_list ap, buffer_t *output, unsigned char flag,
 		num = va_arg(ap, unsigned int);
 	if (len == SHORT)
 		num = (unsigned short)num;
-	if (!(num == 0 && precision == 0))
-		ret += _ubase(output, num, "0123456789", flag,
-				width, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vuint(output, num, 'u', flag, width, precision));
 }
 
 /**
@@ -56,8 +53,6 @@ unsigned int _oct(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
 	unsigned long int num;
-	unsigned int ret = 0;
-	char zero = '0';
 
 	if (len == LONG)
 		num = va_arg(ap, unsigned long int);
@@ -65,12 +60,9 @@ unsigned int _oct(va_list ap, buffer_t *output, unsigned char flag,
 		num = va_arg(ap, unsigned int);
 	if (len == SHORT)
 		num = (unsigned short)num;
-	if (HASH_FLAG == 1 && num != 0)
-		ret += _memcpy(output, &zero, 1);
-	if (!(num == 0 && precision == 0))
-		ret += _ubase(output, num, "01234567", flag, width, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vuint(output, num, 'o', flag, width, precision));
 }
 
 /**
@@ -89,8 +81,6 @@ unsigned int lower_hex(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
 	unsigned long int num;
-	unsigned int ret = 0;
-	char *lead = "0x";
 
 	if (len == LONG)
 		num = va_arg(ap, unsigned long int);
@@ -98,12 +88,9 @@ unsigned int lower_hex(va_list ap, buffer_t *output, unsigned char flag,
 		num = va_arg(ap, unsigned int);
 	if (len == SHORT)
 		num = (unsigned short)num;
-	if (HASH_FLAG == 1 && num != 0)
-		ret += _memcpy(output, lead, 2);
-	if (!(num == 0 && precision  == 0))
-		ret += _ubase(output, num, "0123456789abcdef", flag, width, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vuint(output, num, 'x', flag, width, precision));
 }
 
 /**
@@ -122,8 +109,6 @@ unsigned int upper_hex(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
 	unsigned long int num;
-	unsigned int ret = 0;
-	char *lead = "0X";
 
 	if (len == LONG)
 		num = va_arg(ap, unsigned long);
@@ -131,11 +116,7 @@ unsigned int upper_hex(va_list ap, buffer_t *output, unsigned char flag,
 		num = va_arg(ap, unsigned int);
 	if (len == SHORT)
 		num = (unsigned short)num;
-	if (HASH_FLAG == 1 && num != 0)
-		ret += _memcpy(output, lead, 2);
-	if (!(num == 0 && precision == 0))
-		ret += _ubase(output, num, "0123456789ABCDEF", flag,
-				width, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vuint(output, num, 'X', flag, width, precision));
 }
@@ -8,9 +8,10 @@ unsigned int _r(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len);
 unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len);
+unsigned int _escape(buffer_t *output, const char *str, unsigned int n);
 
 /**
- * _r - rev str
+ * _r - rev str, in blocks written straight into the buffer
  * @ap: arg
  * @output: struct
  * @flag: flag
@@ -24,31 +25,30 @@ unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _r(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	char *str, *null = "(null)";
-	int size, i, end;
-	unsigned int ret = 0;
+	char *str, *null = "(null)", *dst;
+	unsigned int size, n, end, ret = 0;
 
-	(void)flag;
 	(void)len;
 	str = va_arg(ap, char *);
 	if (str == NULL)
 		return (_memcpy(output, null, 6));
-	for (size = 0; *(str + size); )
-		size++;
+	size = end = strlen(str);
 	ret += string_width(output, flag, width, precision, size);
-	end = size - 1;
-	precision = (precision == -1) ? size : precision;
-	for (i = 0; end >= 0 && i < precision; i++)
+	if (precision != -1 && (unsigned int)precision < size)
+		size = precision;
+	for (; size > 0; size -= n, end -= n)
 	{
-		ret += _memcpy(output, (str + end), 1);
-		end--;
+		n = size;
+		dst = _reserve(output, &n);
+		_reverse(dst, str + end - n, n);
+		ret += _commit(output, n);
 	}
 	ret += neg_width(output, ret, flag, width);
 	return (ret);
 }
 
 /**
- * _R - string to rot13 and stores
+ * _R - string to rot13, transformed in place in the buffer
  * @output: struct
  * @ap: arg
  * @flag: flag
@@ -62,33 +62,27 @@ unsigned int _r(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	char *a = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-	char *rot13 = "nopqrstuvwxyzabcdefghijklmNOPQRSTUVWXYZABCDEFGHIJKLM";
-	char *str, *null = "(null)";
-	int i, k, size;
-	unsigned int ret = 0;
+	char *str, *null = "(null)", *dst;
+	unsigned int max, n, k, ret = 0;
 
-	(void)flag;
 	(void)len;
 	str = va_arg(ap, char *);
 	if (str ==  NULL)
 		return (_memcpy(output, null, 6));
-	for (size = 0; *(size + str); )
-		size++;
-	ret += string_width(output, flag, width, precision, size);
-	precision = (precision == -1) ? size : precision;
-	for (i = 0; *(str + i) != '\0' && i < precision; i++)
+	max = (precision == -1) ? UINT_MAX : (unsigned int)precision;
+	n = ((unsigned int)width < max) ? (unsigned int)width : max;
+	if (NEG_FLAG == 0 && width > 0)
+		ret += string_width(output, flag, width, precision,
+				strnlen(str, n));
+	for (; max > 0; str += k, max -= k)
 	{
-		for (k = 0; k < 52; k++)
-		{
-			if (*(str + i) == *(a + k))
-			{
-				ret += _memcpy(output, (rot13 + k), 1);
-				break;
-			}
-		}
-		if (k == 52)
-			ret += _memcpy(output, (str + i), 1);
+		n = max;
+		dst = _reserve(output, &n);
+		k = strnlen(str, n);
+		_rot13(dst, str, k);
+		ret += _commit(output, k);
+		if (k < n)
+			break;
 	}
 	ret += neg_width(output, ret, flag, width);
 	return (ret);
@@ -98,7 +92,7 @@ unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
  * _p - conv arg to hex and stores to buffer
  * @output: struct
  * @ap: arg
- * @flag: flag
+ * @flag: flag, + or space lead the 0x with a sign as glibc does
  * @width: width
  * @precision: precision
  * @len: length
@@ -109,22 +103,22 @@ unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _p(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	char *null = "(nil)";
+	char digits[64];
 	unsigned long int addr;
-	unsigned int ret = 0;
+	int n;
 
 	(void)len;
 	addr = va_arg(ap, unsigned long int);
-	if (addr == '\0')
-		return (_memcpy(output, null, 5));
-	flag |= 32;
-	ret += _ubase(output, addr, "0123456789abcdef", flag, width, precision);
-	ret += neg_width(output, ret, flag, width);
-	return (ret);
+	if (addr == 0)
+		return (_vstr(output, "(nil)", flag, width, -1));
+	n = _digits(digits, addr, 'x');
+	return (_vnum(output, digits + 64 - n, n,
+				PLUS_FLAG ? "+0x" : SPACE_FLAG ? " 0x" : "0x",
+				flag, width, precision));
 }
 
 /**
- * _S - convarg to str then stores to buffer
+ * _S - convarg to str, escaping non-printable bytes as \xHH
  * @ap: arg
  * @flag: flag
  * @output: struct
@@ -137,31 +131,53 @@ unsigned int _p(va_list ap, buffer_t *output, unsigned char flag,
 unsigned int _S(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len)
 {
-	char *str, *null = "(null)", *hex = "\\x", zero = '0';
-	int size, i;
-	unsigned int ret = 0;
+	char *str, *null = "(null)";
+	unsigned int max, win, n, ret = 0;
 
 	(void)len;
 	str = va_arg(ap, char *);
 	if (str == NULL)
 		return (_memcpy(output, null, 6));
-	for (size = 0; str[size]; )
-		size++;
-	ret += string_width(output, flag, width, precision, size);
-	precision = (precision == -1) ? size : precision;
-	for (i = 0; *(str + i) != '\0' && i < precision; i++)
+	max = (precision == -1) ? UINT_MAX : (unsigned int)precision;
+	n = ((unsigned int)width < max) ? (unsigned int)width : max;
+	if (NEG_FLAG == 0 && width > 0)
+		ret += string_width(output, flag, width, precision,
+				strnlen(str, n));
+	for (; max > 0; str += n, max -= n)
 	{
-		if (*(str + i) < 32 || *(str + i) >= 127)
-		{
-			ret += _memcpy(output, hex, 2);
-			if (*(str + i) < 16)
-				ret += _memcpy(output, &zero, 1);
-			ret += _ubase(output, *(str + i), "0123456789ABCDEF",
-					flag, 0, 0);
-			continue;
-		}
-		ret += _memcpy(output, (str + i), 1);
+		win = (max < 256) ? max : 256;
+		n = strnlen(str, win);
+		ret += _escape(output, str, n);
+		if (n < win)
+			break;
 	}
 	ret += neg_width(output, ret, flag, width);
 	return (ret);
 }
+
+/**
+ * _escape - stores n bytes, printable runs in bulk and others as \xHH
+ * @output: struct
+ * @str: bytes, no NUL among the first n
+ * @n: no of bytes
+ *
+ * Return: number of bytes stored to buf
+ */
+unsigned int _escape(buffer_t *output, const char *str, unsigned int n)
+{
+	char *hex = "0123456789ABCDEF", esc[4] = {'\\', 'x', 0, 0};
+	unsigned int i, run, ret = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		run = _print_span(str + i, n - i);
+		ret += _memcpy(output, str + i, run);
+		i += run;
+		if (i == n)
+			break;
+		esc[2] = hex[(unsigned char)str[i] >> 4];
+		esc[3] = hex[(unsigned char)str[i] & 15];
+		ret += _memcpy(output, esc, 4);
+	}
+	return (ret);
+}
@@ -0,0 +1,118 @@
+#include "main.h"
+
+unsigned int _json(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _logfmt(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _jescape(buffer_t *output, const char *str, unsigned int n);
+unsigned int _jstring(buffer_t *output, const char *str, unsigned int max);
+
+/**
+ * _json - stores arg as a quoted, escaped json string
+ * @ap: arg
+ * @output: struct
+ * @flag: flag
+ * @width: width, not applied to structured output
+ * @precision: prec, max no of input bytes
+ * @len: length
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _json(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	(void)flag;
+	(void)width;
+	(void)len;
+	return (_vjson(output, va_arg(ap, char *), 'j', precision));
+}
+
+/**
+ * _logfmt - stores arg as a logfmt value, bare when it can be and
+ * otherwise quoted and escaped like json
+ * @ap: arg
+ * @output: struct
+ * @flag: flag
+ * @width: width, not applied to structured output
+ * @precision: prec, max no of input bytes
+ * @len: length
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _logfmt(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	(void)flag;
+	(void)width;
+	(void)len;
+	return (_vjson(output, va_arg(ap, char *), 'J', precision));
+}
+
+/**
+ * _jstring - stores at most max bytes of a string in json quotes,
+ * scanning a window at a time so no byte past the cap is read
+ * @output: struct
+ * @str: string
+ * @max: cap on the no of input bytes
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _jstring(buffer_t *output, const char *str, unsigned int max)
+{
+	char quote = '"';
+	unsigned int win, n, ret = 0;
+
+	ret += _memcpy(output, &quote, 1);
+	for (; max > 0; str += n, max -= n)
+	{
+		win = (max < 256) ? max : 256;
+		n = strnlen(str, win);
+		ret += _jescape(output, str, n);
+		if (n < win)
+			break;
+	}
+	ret += _memcpy(output, &quote, 1);
+	return (ret);
+}
+
+/**
+ * _jescape - stores n bytes, clean runs in bulk and the rest as json
+ * escapes; bytes >= 0x80 are passed through as utf-8
+ * @output: struct
+ * @str: bytes, no NUL among the first n
+ * @n: no of bytes
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _jescape(buffer_t *output, const char *str, unsigned int n)
+{
+	char *hex = "0123456789abcdef", *names = "btn.fr";
+	char esc[6] = {'\\', 'u', '0', '0', 0, 0};
+	unsigned int i, run, ret = 0;
+	unsigned char c;
+
+	for (i = 0; i < n; i++)
+	{
+		run = _quote_span(str + i, n - i, 0x20, "\"\\\"");
+		ret += _memcpy(output, str + i, run);
+		i += run;
+		if (i == n)
+			break;
+		c = str[i];
+		if (c == '"' || c == '\\' || (c >= 8 && c <= 13 && c != 11))
+		{
+			esc[1] = (c >= 8 && c <= 13) ? names[c - 8] : c;
+			ret += _memcpy(output, esc, 2);
+			continue;
+		}
+		esc[1] = 'u';
+		esc[4] = hex[c >> 4];
+		esc[5] = hex[c & 15];
+		ret += _memcpy(output, esc, 6);
+	}
+	return (ret);
+}
@@ -0,0 +1,84 @@
+#include "main.h"
+
+unsigned int _bytes(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _duration(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _timestamp(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+
+/**
+ * _bytes - stores an unsigned byte count in human readable units
+ * @ap: arg
+ * @output: struct
+ * @flag: flag, # for decimal units
+ * @width: width
+ * @precision: decimals
+ * @len: length
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _bytes(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	unsigned long int num;
+
+	if (len == LONG)
+		num = va_arg(ap, unsigned long int);
+	else
+		num = va_arg(ap, unsigned int);
+	if (len == SHORT)
+		num = (unsigned short)num;
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_vbytes(output, num, flag, width, precision));
+}
+
+/**
+ * _duration - stores a signed nanosecond count as a duration
+ * @ap: arg
+ * @output: struct
+ * @flag: flag
+ * @width: width
+ * @precision: decimals
+ * @len: length
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _duration(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	long int ns;
+
+	if (len == LONG)
+		ns = va_arg(ap, long int);
+	else
+		ns = va_arg(ap, int);
+	if (len == SHORT)
+		ns = (short)ns;
+	else if (len == CHAR)
+		ns = (signed char)ns;
+	return (_vdur(output, ns, flag, width, precision));
+}
+
+/**
+ * _timestamp - stores the current time as ISO 8601, takes no arg
+ * @ap: arg, unused
+ * @output: struct
+ * @flag: flag, # for UTC
+ * @width: width
+ * @precision: fraction digits
+ * @len: length, unused
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _timestamp(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	(void)ap;
+	(void)len;
+	return (_vtime(output, flag, width, precision));
+}
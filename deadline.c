@@ -0,0 +1,157 @@
+#include "main.h"
+#include <errno.h>
+
+long int _printf_buffered(long int ms);
+buffer_t *_dl_buffer(void);
+int _dl_commit(buffer_t *output);
+int _dl_write(int fd, const char *s, unsigned int n);
+int _printf_flush(void);
+
+static deferred_t later = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+	0, 0, 0, {0}};
+static const sink_t dl_sink = {_dl_commit, _dl_commit, _dl_commit,
+	_dl_commit, 0};
+
+/**
+ * _printf_buffered - keeps _printf output in one buffer shared by all
+ * calls, written when full, when its oldest byte is ms old, by
+ * _printf_flush, at exit or on a fatal signal
+ * @ms: deadline in ms, 0 to write every call out again, -1 to only query
+ *
+ * Return: the previous deadline, -1 if the flush thread can't start
+ */
+
+long int _printf_buffered(long int ms)
+{
+	static int started;
+	long int prev = __atomic_load_n(&later.deadline, __ATOMIC_RELAXED) /
+		1000000;
+
+	if (ms < 0)
+		return (prev);
+	pthread_mutex_lock(&later.lock);
+	if (ms > 0 && !started)
+		started = (_dl_start(&later) == 0);
+	if (ms == 0 || started)
+	{
+		_dl_write(1, later.data, later.len);
+		later.len = 0;
+		__atomic_store_n(&later.deadline, ms * 1000000UL,
+				__ATOMIC_RELAXED);
+		pthread_cond_signal(&later.wake);
+	}
+	pthread_mutex_unlock(&later.lock);
+	return ((ms > 0 && !started) ? -1 : prev);
+}
+
+/**
+ * _dl_buffer - buffer of one _printf call that hands its bytes to the
+ * shared buffer instead of writing them
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_dl_buffer(void)
+{
+	buffer_t *output = init_buffer(1, BUFF_SIZE);
+
+	if (output != NULL)
+	{
+		output->sink = &dl_sink;
+		output->data = &later;
+	}
+	return (output);
+}
+
+/**
+ * _dl_commit - moves the bytes of a call into the shared buffer, writing
+ * the shared buffer first if they don't fit; wakes the flush thread when
+ * the shared buffer stops being empty. Once the deadline is off and the
+ * shared buffer empty the bytes are written without taking the lock
+ * @output: struct
+ *
+ * Return: no of bytes moved, -1 on a write error
+ */
+
+int _dl_commit(buffer_t *output)
+{
+	deferred_t *d = output->data;
+	unsigned int n = output->len;
+	int ret = n;
+
+	if (n == 0)
+		return (0);
+	if (__atomic_load_n(&d->deadline, __ATOMIC_ACQUIRE) == 0 &&
+			__atomic_load_n(&d->len, __ATOMIC_RELAXED) == 0)
+		return (_fd_flush(output));
+	pthread_mutex_lock(&d->lock);
+	if (d->len + n > DEFER_SIZE || d->deadline == 0)
+	{
+		ret = _dl_write(1, d->data, d->len);
+		d->len = 0;
+	}
+	if (n > DEFER_SIZE || d->deadline == 0)
+		ret = (_dl_write(1, output->start, n) < 0) ? -1 : ret;
+	else
+	{
+		if (d->len == 0)
+		{
+			d->oldest = _dl_now();
+			pthread_cond_signal(&d->wake);
+		}
+		memcpy(d->data + d->len, output->start, n);
+		d->len += n;
+	}
+	pthread_mutex_unlock(&d->lock);
+	output->error |= (ret < 0);
+	output->buffer = output->start;
+	output->len = 0;
+	output->flushes++;
+	return ((ret < 0) ? -1 : (int)n);
+}
+
+/**
+ * _dl_write - writes all of n bytes, async signal safe
+ * @fd: file descriptor
+ * @s: bytes
+ * @n: no of bytes
+ *
+ * Return: no of bytes written, -1 on a write error
+ */
+
+int _dl_write(int fd, const char *s, unsigned int n)
+{
+	unsigned int done = 0;
+	ssize_t w;
+
+	while (done < n)
+	{
+		w = write(fd, s + done, n - done);
+		if (w < 0 && errno == EINTR)
+			continue;
+		if (w <= 0)
+			return (-1);
+		done += w;
+	}
+	return (done);
+}
+
+/**
+ * _printf_flush - writes what _printf_buffered holds back now, without
+ * locking when it holds nothing
+ *
+ * Return: no of bytes written, -1 on a write error
+ */
+
+int _printf_flush(void)
+{
+	int ret;
+
+	if (__atomic_load_n(&later.len, __ATOMIC_RELAXED) == 0)
+		return (0);
+	pthread_mutex_lock(&later.lock);
+	ret = _dl_write(1, later.data, later.len);
+	later.len = 0;
+	pthread_mutex_unlock(&later.lock);
+	return (ret);
+}
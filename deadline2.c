@@ -0,0 +1,128 @@
+#include "main.h"
+#include <signal.h>
+#include <time.h>
+
+int _dl_start(deferred_t *d);
+void *_dl_thread(void *arg);
+void _dl_fatal(int sig);
+void _dl_exit(void);
+unsigned long int _dl_now(void);
+
+static deferred_t *pending;
+
+/**
+ * _dl_start - starts the flush thread of a shared buffer, with every
+ * signal blocked, and writes the buffer at exit and on fatal signals
+ * nobody else handles; once, with the buffer locked
+ * @d: shared buffer
+ *
+ * Return: 0, -1 if the thread can't start
+ */
+
+int _dl_start(deferred_t *d)
+{
+	static const int fatal[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT,
+		SIGTERM, SIGINT, SIGHUP};
+	pthread_condattr_t attr;
+	struct sigaction sa, old;
+	sigset_t all, mask;
+	pthread_t thread;
+	unsigned int i;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_destroy(&d->wake);
+	pthread_cond_init(&d->wake, &attr);
+	pthread_condattr_destroy(&attr);
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &mask);
+	i = pthread_create(&thread, NULL, _dl_thread, d);
+	pthread_sigmask(SIG_SETMASK, &mask, NULL);
+	if (i != 0)
+		return (-1);
+	pthread_detach(thread);
+	pending = d;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = _dl_fatal;
+	sa.sa_flags = SA_RESETHAND;
+	sigemptyset(&sa.sa_mask);
+	for (i = 0; i < sizeof(fatal) / sizeof(fatal[0]); i++)
+		if (sigaction(fatal[i], NULL, &old) == 0 &&
+				old.sa_handler == SIG_DFL)
+			sigaction(fatal[i], &sa, NULL);
+	atexit(_dl_exit);
+	return (0);
+}
+
+/**
+ * _dl_thread - writes the shared buffer once its oldest byte reaches the
+ * deadline; sleeps with no timer while the buffer is empty
+ * @arg: shared buffer
+ *
+ * Return: never returns
+ */
+
+void *_dl_thread(void *arg)
+{
+	deferred_t *d = arg;
+	struct timespec due;
+	unsigned long int at;
+
+	pthread_mutex_lock(&d->lock);
+	for (;;)
+	{
+		while (d->len == 0 || d->deadline == 0)
+			pthread_cond_wait(&d->wake, &d->lock);
+		at = d->oldest + d->deadline;
+		if (_dl_now() >= at)
+		{
+			_dl_write(1, d->data, d->len);
+			d->len = 0;
+			continue;
+		}
+		due.tv_sec = at / 1000000000UL;
+		due.tv_nsec = at % 1000000000UL;
+		pthread_cond_timedwait(&d->wake, &d->lock, &due);
+	}
+	return (NULL);
+}
+
+/**
+ * _dl_fatal - writes the shared buffer as the process dies, without the
+ * lock (the thread that died may hold it), then lets the signal's default
+ * action run
+ * @sig: signal
+ */
+
+void _dl_fatal(int sig)
+{
+	unsigned int n = pending->len;
+
+	pending->len = 0;
+	if (n <= DEFER_SIZE)
+		_dl_write(1, pending->data, n);
+	raise(sig);
+}
+
+/**
+ * _dl_exit - writes the shared buffer at exit
+ */
+
+void _dl_exit(void)
+{
+	_printf_flush();
+}
+
+/**
+ * _dl_now - monotonic clock
+ *
+ * Return: ns
+ */
+
+unsigned long int _dl_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
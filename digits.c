@@ -0,0 +1,167 @@
+#include "main.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+unsigned int _utoa(char *dst, unsigned long int num);
+unsigned int _vdec(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width);
+long int _ctx_column(printf_ctx_t *ctx, const char *format,
+		const void *values, unsigned long int count);
+
+#if defined(__SSE2__)
+__m128i _digits8(unsigned int num);
+
+/**
+ * _digits8 - splits a value below 10^8 into its 8 decimal digits, one
+ * per 16 bit lane, with multiply-high reciprocals instead of divisions
+ * @num: value
+ *
+ * Return: digits, most significant first
+ */
+
+__m128i _digits8(unsigned int num)
+{
+	__m128i v, abcd, efgh;
+
+	v = _mm_cvtsi32_si128(num);
+	abcd = _mm_srli_epi64(_mm_mul_epu32(v,
+				_mm_set1_epi32((int)0xd1b71759)), 45);
+	efgh = _mm_sub_epi32(v, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+	v = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+	v = _mm_unpacklo_epi16(v, v);
+	v = _mm_unpacklo_epi32(v, v);
+	v = _mm_mulhi_epu16(v, _mm_set_epi16(-32768, 13108, 5243, 8389,
+				-32768, 13108, 5243, 8389));
+	v = _mm_mulhi_epu16(v, _mm_set_epi16(-32768, 8192, 2048, 128,
+				-32768, 8192, 2048, 128));
+	efgh = _mm_mullo_epi16(v, _mm_set1_epi16(10));
+	return (_mm_sub_epi16(v, _mm_slli_epi64(efgh, 16)));
+}
+#endif
+
+/**
+ * _utoa - converts to decimal, 16 digits at a time with SSE2
+ * @dst: 20 bytes, the digits end at dst + 20
+ * @num: value
+ *
+ * Return: no of digits, they start at dst + 20 - n
+ */
+
+unsigned int _utoa(char *dst, unsigned long int num)
+{
+	static const unsigned long int pow10[] = {1UL, 10UL, 100UL, 1000UL,
+		10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL,
+		1000000000UL, 10000000000UL, 100000000000UL, 1000000000000UL,
+		10000000000000UL, 100000000000000UL, 1000000000000000UL,
+		10000000000000000UL, 100000000000000000UL,
+		1000000000000000000UL, 10000000000000000000UL};
+	unsigned int n, t, i;
+	unsigned long int low;
+
+	t = ((64 - __builtin_clzl(num | 1)) * 1233) >> 12;
+	n = t + 1 - (num < pow10[t]);
+	n += (n == 0);
+	low = num % pow10[16];
+#if defined(__SSE2__)
+	_mm_storeu_si128((__m128i *)(dst + 4), _mm_add_epi8(
+				_mm_packus_epi16(_digits8(low / 100000000),
+					_digits8(low % 100000000)),
+				_mm_set1_epi8('0')));
+	i = 4;
+#else
+	for (i = 20; i > 4; low /= 10)
+		dst[--i] = '0' + low % 10;
+#endif
+	for (num /= pow10[16]; i > 0; num /= 10)
+		dst[--i] = '0' + num % 10;
+	return (n);
+}
+
+/**
+ * _vdec - stores a decimal with sign and width straight into the buffer,
+ * as _vint (%d, %i) or _vuint (%u) would without a precision
+ * @output: struct
+ * @d: value, read as unsigned long for %u
+ * @spec: d, i or u
+ * @flag: flag, not both PLUS and SPACE
+ * @width: width
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vdec(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width)
+{
+	char digits[20], sign = 0, *dst;
+	unsigned long int num = d;
+	unsigned int n, len, pad, room;
+
+	if (spec != 'u')
+	{
+		num = (d < 0) ? -num : num;
+		sign = (d < 0) ? '-' : PLUS_FLAG ? '+' : SPACE_FLAG ? ' ' : 0;
+	}
+	n = _utoa(digits, num);
+	len = n + (sign != 0);
+	pad = (width > (int)len) ? width - len : 0;
+	room = len + pad;
+	dst = _reserve(output, &room);
+	if (room < len + pad && spec == 'u')
+		return (_vuint(output, num, spec, flag, width, -1));
+	if (room < len + pad)
+		return (_vint(output, d, flag, width, -1));
+	if (NEG_FLAG == 0 && ZERO_FLAG == 0)
+		memset(dst, ' ', pad);
+	dst += (NEG_FLAG == 0 && ZERO_FLAG == 0) ? pad : 0;
+	if (sign)
+		*dst++ = sign;
+	if (NEG_FLAG == 0 && ZERO_FLAG == 1)
+		memset(dst, '0', pad);
+	dst += (NEG_FLAG == 0 && ZERO_FLAG == 1) ? pad : 0;
+	memcpy(dst, digits + 20 - n, n);
+	if (NEG_FLAG == 1)
+		memset(dst + n, ' ', pad);
+	return (_commit(output, len + pad));
+}
+
+/**
+ * _ctx_column - formats an array of values with one directive each, eg
+ * "%8d" or "%ld," for a column; the format's text repeats per value
+ * @ctx: context
+ * @format: one directive, see _printf_compile, with any text around it
+ * @values: array of the type the directive reads (int for %d, long for
+ * %ld, short for %hd, char for %c and %hhd, char * for %s)
+ * @count: no of values
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+long int _ctx_column(printf_ctx_t *ctx, const char *format,
+		const void *values, unsigned long int count)
+{
+	static const unsigned long int at[] = {0};
+	fmt_op_t *ops;
+	unsigned long int size;
+	long int ret = -1;
+
+	ops = _printf_compile(format);
+	if (ops != NULL && ops[0].spec != 0 && ops[0].spec != '%' &&
+			ops[1].spec == 0)
+	{
+		if (strchr("sjJ", ops[0].spec))
+			size = sizeof(char *);
+		else if (ops[0].spec == 'c' || ops[0].len == CHAR)
+			size = sizeof(char);
+		else if (ops[0].len == LONG)
+			size = sizeof(long int);
+		else if (ops[0].len == SHORT)
+			size = sizeof(short);
+		else
+			size = sizeof(int);
+		ret = _ctx_batch(ctx, ops, values, count, size, at);
+	}
+	free(ops);
+	return (ret);
+}
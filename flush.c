@@ -0,0 +1,129 @@
+#include "main.h"
+#include <errno.h>
+
+buffer_t *init_buffer(int fd, unsigned int size);
+int _flush(buffer_t *output);
+int _fd_flush(buffer_t *output);
+int _close(buffer_t *output);
+int _trim(buffer_t *output);
+
+static const sink_t fd_sink = {_fd_flush, NULL, _fd_flush, _fd_flush, 0};
+
+/**
+ * init_buffer - initializes buffer_t writing to a file descriptor
+ * @fd: file descriptor to flush to
+ * @size: capacity, BUFF_SIZE if 0
+ *
+ * Return: pointer to buffer_t
+ */
+
+buffer_t *init_buffer(int fd, unsigned int size)
+{
+	buffer_t *output;
+	char *start;
+
+	if (size == 0)
+		size = BUFF_SIZE;
+	start = _pool_get(size);
+	if (start == NULL)
+		return (NULL);
+	output = _buffer(start, size, &fd_sink, NULL);
+	if (output == NULL)
+	{
+		_pool_put(start, size);
+		return (NULL);
+	}
+	output->fd = fd;
+	return (output);
+}
+
+/**
+ * _flush - hands the buffered bytes to the sink
+ * @output: struct
+ *
+ * Return: no of bytes flushed, -1 on error
+ */
+
+int _flush(buffer_t *output)
+{
+	if (output->sink->flush == NULL)
+		return (0);
+	_account(output, FLUSH_EXPLICIT);
+	return (output->sink->flush(output));
+}
+
+/**
+ * _close - final flush, releases the sink's destination
+ * @output: struct, free it afterwards with free_buffer
+ *
+ * Return: 0, -1 if the sink failed at any point
+ */
+
+int _close(buffer_t *output)
+{
+	_account(output, FLUSH_END);
+	if (output->sink->close != NULL && output->sink->close(output) < 0)
+		output->error = 1;
+	return (output->error ? -1 : 0);
+}
+
+/**
+ * _fd_flush - writes out the buffered bytes and empties the buffer, the
+ * error flag is set when any of them could not be written
+ * @output: struct
+ *
+ * Return: no of bytes written, -1 on a write error
+ */
+
+int _fd_flush(buffer_t *output)
+{
+	unsigned int done = 0;
+	ssize_t n = 0;
+
+	while (done < output->len)
+	{
+		n = write(output->fd, output->start + done, output->len - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		done += n;
+	}
+	if (output->len > 0)
+		output->flushes++;
+	if (done < output->len)
+		output->error = 1;
+	output->buffer = output->start;
+	output->len = 0;
+	return ((n < 0) ? -1 : (int)done);
+}
+
+/**
+ * _trim - writes out an init_buffer buffer and swaps its storage for the
+ * smallest block that holds what it held at most, so an idle long-lived
+ * buffer keeps only what its load needs; the high water mark starts over
+ * @output: struct
+ *
+ * Return: the capacity now, -1 if the buffer is another sink's or the
+ * write failed
+ */
+
+int _trim(buffer_t *output)
+{
+	unsigned int size = BUFF_SIZE;
+	char *start;
+
+	if (output->sink != &fd_sink || _flush(output) < 0)
+		return (-1);
+	while (size < output->high && size < output->size)
+		size *= 2;
+	start = (size < output->size) ? _pool_get(size) : NULL;
+	if (start != NULL)
+	{
+		_pool_put(output->start, output->size);
+		output->buffer = output->start = start;
+		output->size = size;
+	}
+	output->high = 0;
+	return (output->size);
+}
@@ -8,7 +8,8 @@ int _width(va_list ap, const char *modifier, char *i);
 int _precision(va_list ap, const char *modifier, char *i);
 
 /**
-* _length - matches length mod with corr value
+* _length - matches length mod with corr value, ll is read as l since
+* both are 64 bits here, hh as CHAR
 * @modifier: pointer
 * @i: index counter
 * Return: corr value or 0
@@ -17,12 +18,12 @@ unsigned char _length(const char *modifier, char *i)
 {
 	if (*modifier == 'h')
 	{
-		(*i)++;
-		return (SHORT);
+		(*i) += 1 + (modifier[1] == 'h');
+		return ((modifier[1] == 'h') ? CHAR : SHORT);
 	}
 	else if (*modifier == 'l')
 	{
-		(*i)++;
+		(*i) += 1 + (modifier[1] == 'l');
 		return (LONG);
 	}
 	return (0);
@@ -33,25 +34,21 @@ unsigned char _length(const char *modifier, char *i)
 * @ap: arg
 * @modifier: pointer
 * @i: index counter
-* Return: value or 0
+* Return: value or 0, negative if * reads one (- flag and its magnitude)
 */
 int _width(va_list ap, const char *modifier, char *i)
 {
 	int val = 0;
 
-	while ((*modifier >= '0' && *modifier <= '9') || (*modifier == '*'))
+	if (*modifier == '*')
 	{
 		(*i)++;
-		if (*modifier == '*')
-		{
-			val = va_arg(ap, int);
-			if (val <= 0)
-				return (0);
-			return (val);
-		}
-		val *= 10;
-		val += (*modifier - '0');
-		modifier++;
+		return (va_arg(ap, int));
+	}
+	for (; *modifier >= '0' && *modifier <= '9'; modifier++)
+	{
+		(*i)++;
+		val = val * 10 + (*modifier - '0');
 	}
 	return (val);
 }
@@ -61,7 +58,7 @@ int _width(va_list ap, const char *modifier, char *i)
 * @ap: arg
 * @modifier: pointer
 * @i: index counter
-* Return: value or 0
+* Return: value, 0 for a lone '.', -1 if none or if * reads a negative
 */
 int _precision(va_list ap, const char *modifier, char *i)
 {
@@ -69,29 +66,17 @@ int _precision(va_list ap, const char *modifier, char *i)
 
 	if (*modifier != '.')
 		return (-1);
-	modifier++;
 	(*i)++;
-	if ((*modifier <= '0' || *modifier > '9') &&
-			*modifier != '*')
+	if (modifier[1] == '*')
 	{
-		if (*modifier == '0')
-			(*i)++;
-		return (0);
+		(*i)++;
+		val = va_arg(ap, int);
+		return ((val < 0) ? -1 : val);
 	}
-	while ((*modifier >= '0' && *modifier <= '9') ||
-			(*modifier == '*'))
+	for (modifier++; *modifier >= '0' && *modifier <= '9'; modifier++)
 	{
 		(*i)++;
-		if (*modifier == '*')
-		{
-			val = va_arg(ap, int);
-			if (val <= 0)
-				return (0);
-			return (val);
-		}
-		val *= 10;
-		val += (*modifier - '0');
-		modifier++;
+		val = val * 10 + (*modifier - '0');
 	}
 	return (val);
 }
@@ -107,12 +92,13 @@ unsigned char _flag(const char *flag, char *i)
 {
 	int j, k;
 	unsigned char ret = 0;
-	flag_t flags[] = {
+	static const flag_t flags[] = {
 		{'+', PLUS},
 		{'-', NEG},
 		{' ', SPACE},
 		{'#', HASH},
 		{'0', ZERO},
+		{'\'', GROUP},
 		{0, 0}
 	};
 
@@ -148,7 +134,7 @@ unsigned int (*_specifiers(const char *spec))(va_list, buffer_t *,
 		unsigned char, int, int, unsigned char)
 {
 	int i;
-	converter_t conv[] = {
+	static const converter_t conv[] = {
 		{'c', _char},
 		{'s', _string},
 		{'%', _perc},
@@ -163,6 +149,11 @@ unsigned int (*_specifiers(const char *spec))(va_list, buffer_t *,
 		{'p', _p},
 		{'r', _r},
 		{'R', _R},
+		{'j', _json},
+		{'J', _logfmt},
+		{'B', _bytes},
+		{'D', _duration},
+		{'T', _timestamp},
 		{0, NULL}
 	};
 
@@ -1,11 +1,54 @@
 #include "main.h"
 
 unsigned int _memcpy(buffer_t *output, const char *src, unsigned int n);
+char *_reserve(buffer_t *output, unsigned int *n);
+unsigned int _commit(buffer_t *output, unsigned int n);
 void free_buffer(buffer_t *output);
-buffer_t *init_buffer(void);
+buffer_t *_buffer(char *start, unsigned int size, const sink_t *sink,
+		void *data);
 
 /**
- * _memcpy - copies n bytes fromsrc to buffer
+ * _reserve - hands out contiguous free space in the buffer, asking the
+ * sink for room when it is full
+ * @output: struct
+ * @n: bytes wanted, updated to the bytes granted (at least 1)
+ *
+ * Return: pointer to write the granted bytes to, then _commit them
+ */
+
+char *_reserve(buffer_t *output, unsigned int *n)
+{
+	unsigned int room = output->size - output->len;
+
+	if (room == 0)
+	{
+		_account(output, output->sink->grows ? FLUSH_GROW : FLUSH_FULL);
+		output->sink->reserve(output);
+		room = output->size - output->len;
+	}
+	if (*n > room)
+		*n = room;
+	return (output->buffer);
+}
+
+/**
+ * _commit - accounts for bytes written after _reserve, a full buffer
+ * is handed to the sink on the next _reserve
+ * @output: struct
+ * @n: bytes written, at most the bytes granted
+ *
+ * Return: bytes committed
+ */
+
+unsigned int _commit(buffer_t *output, unsigned int n)
+{
+	output->len += n;
+	output->buffer += n;
+	return (n);
+}
+
+/**
+ * _memcpy - copies n bytes fromsrc to buffer in bulk chunks
  * @output: struct
  * @src: pointer
  * @n: number of bytes
@@ -15,58 +58,57 @@ buffer_t *init_buffer(void);
 
 unsigned int _memcpy(buffer_t *output, const char *src, unsigned int n)
 {
-	unsigned int i;
+	unsigned int i, room;
+	char *dst;
 
-	for (i = 0 ; i < n ; i++)
+	for (i = 0 ; i < n ; i += room)
 	{
-		*(output->buffer) = *(src + i);
-		(output->len)++;
-
-		if (output->len == 1024)
-		{
-			write(1, output->start, output->len);
-			output->buffer = output->start;
-			output->len = 0;
-		}
-		else
-			(output->buffer)++;
+		room = n - i;
+		dst = _reserve(output, &room);
+		memcpy(dst, src + i, room);
+		_commit(output, room);
 	}
 	return (n);
 }
 
 /**
- * free_buffer - frees struct buffer
+ * free_buffer - frees struct buffer, _close it first
  * @output: buffer to be freed
  */
 
 void free_buffer(buffer_t *output)
 {
-	free(output->start);
-	free(output);
+	_pool_put(output->start, output->size);
+	_pool_put(output, sizeof(buffer_t));
 }
 
 /**
- * init_buffer - initializes buffer_t
+ * _buffer - allocates a buffer_t over start
+ * @start: storage the converters write to
+ * @size: capacity of start
+ * @sink: backend ops
+ * @data: backend state
  *
- * Return: pointer to buffer_t
+ * Return: pointer to buffer_t, NULL on failure
  */
 
-buffer_t *init_buffer(void)
+buffer_t *_buffer(char *start, unsigned int size, const sink_t *sink,
+		void *data)
 {
 	buffer_t *output;
 
-	output = malloc(sizeof(buffer_t));
+	output = _pool_get(sizeof(buffer_t));
 	if (output == NULL)
 		return (NULL);
-
-	output->buffer = malloc(sizeof(char) * 1024);
-	if (output->buffer == NULL)
-	{
-		free(output);
-		return (NULL);
-	}
-
-	output->start = output->buffer;
+	output->buffer = output->start = start;
 	output->len = 0;
+	output->size = size;
+	output->fd = -1;
+	output->flushes = 0;
+	output->error = 0;
+	output->sink = sink;
+	output->data = data;
+	output->high = 0;
+	memset(output->flushed, 0, sizeof(output->flushed));
 	return (output);
 }
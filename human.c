@@ -0,0 +1,200 @@
+#include "main.h"
+
+unsigned int _group(char *dst, unsigned long int num);
+unsigned int _vgroup(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width, int precision);
+unsigned int _scaled(char *dst, unsigned long int num, unsigned long int unit,
+		int decimals);
+unsigned int _vbytes(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision);
+unsigned int _vdur(buffer_t *output, long int ns, unsigned char flag,
+		int width, int precision);
+
+/**
+ * _group - writes a decimal with a comma between groups of three digits
+ * @dst: 27 bytes
+ * @num: value
+ *
+ * Return: no of bytes written
+ */
+
+unsigned int _group(char *dst, unsigned long int num)
+{
+	char digits[20];
+	unsigned int n, i, k = 0;
+
+	n = _utoa(digits, num);
+	for (i = 0; i < n; i++)
+	{
+		dst[k++] = digits[20 - n + i];
+		if ((n - 1 - i) % 3 == 0 && i + 1 < n)
+			dst[k++] = ',';
+	}
+	return (k);
+}
+
+/**
+ * _vgroup - stores a grouped decimal (' flag) with sign, width and
+ * precision; zeros from the precision or the 0 flag are not grouped
+ * @output: struct
+ * @d: value, read as unsigned long for %u
+ * @spec: d, i or u
+ * @flag: flag
+ * @width: width, counting the separators
+ * @precision: min no of digits, -1 if none
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vgroup(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width, int precision)
+{
+	char text[28], sign = 0;
+	unsigned long int num = d;
+	int n, zeros, pad, ret;
+
+	if (spec != 'u')
+	{
+		num = (d < 0) ? -num : num;
+		sign = (d < 0) ? '-' : PLUS_FLAG ? '+' : SPACE_FLAG ? ' ' : 0;
+	}
+	n = (num == 0 && precision == 0) ? 0 : (int)_group(text, num);
+	zeros = (precision > n - n / 4) ? precision - (n - n / 4) : 0;
+	pad = width - n - zeros - (sign != 0);
+	pad = (pad > 0) ? pad : 0;
+	if (ZERO_FLAG == 1 && NEG_FLAG == 0 && precision == -1)
+	{
+		zeros += pad;
+		pad = 0;
+	}
+	ret = (NEG_FLAG == 0) ? _fill(output, ' ', pad) : 0;
+	ret += _memcpy(output, &sign, sign != 0);
+	ret += _fill(output, '0', zeros);
+	ret += _memcpy(output, text, n);
+	ret += (NEG_FLAG == 1) ? _fill(output, ' ', pad) : 0;
+	return (ret);
+}
+
+/**
+ * _scaled - writes num / unit with decimals digits of its fraction,
+ * truncated, never rounded up
+ * @dst: 24 bytes
+ * @num: value
+ * @unit: divisor
+ * @decimals: 0 to 3
+ *
+ * Return: no of bytes written
+ */
+
+unsigned int _scaled(char *dst, unsigned long int num, unsigned long int unit,
+		int decimals)
+{
+	static const unsigned long int scale[] = {1, 10, 100, 1000};
+	char digits[20];
+	unsigned long int r = num % unit, frac;
+	unsigned int n;
+	int i;
+
+	n = _utoa(digits, num / unit);
+	memcpy(dst, digits + 20 - n, n);
+	if (decimals == 0)
+		return (n);
+	for (; unit > ULONG_MAX / 1000; unit >>= 4)
+		r >>= 4;
+	frac = r * scale[decimals] / unit;
+	dst[n] = '.';
+	for (i = decimals; i > 0; i--, frac /= 10)
+		dst[n + i] = '0' + frac % 10;
+	return (n + 1 + decimals);
+}
+
+/**
+ * _vbytes - stores a byte count in the largest binary unit it reaches
+ * (%B), eg 1.5 MiB, or in decimal units (kB, MB) with the # flag
+ * @output: struct
+ * @num: no of bytes
+ * @flag: flag
+ * @width: width
+ * @precision: decimals, 1 if none, at most 3
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vbytes(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision)
+{
+	static const char * const iec[] = {" B", " KiB", " MiB", " GiB", " TiB",
+		" PiB", " EiB"};
+	static const char * const si[] = {" B", " kB", " MB", " GB", " TB",
+		" PB", " EB"};
+	const char *name;
+	char text[32];
+	unsigned long int step = HASH_FLAG ? 1000 : 1024, unit = 1;
+	unsigned int u, n, ret;
+
+	for (u = 0; u < 6 && num / unit >= step; u++)
+		unit *= step;
+	precision = (u == 0) ? 0 : (precision == -1) ? 1 :
+		(precision > 3) ? 3 : precision;
+	n = _scaled(text, num, unit, precision);
+	name = HASH_FLAG ? si[u] : iec[u];
+	memcpy(text + n, name, strlen(name));
+	n += strlen(name);
+	ret = print_width(output, n, flag, width);
+	ret += _memcpy(output, text, n);
+	ret += neg_width(output, n, flag, width);
+	return (ret);
+}
+
+/**
+ * _vdur - stores a duration given in nanoseconds (%D): 850ns, 12.5us,
+ * 3.2ms and 1.5s below a minute, then 2m05s, 3h07m and 4d02h
+ * @output: struct
+ * @ns: nanoseconds, may be negative
+ * @flag: flag
+ * @width: width
+ * @precision: decimals below a minute, 1 if none, at most 3
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vdur(buffer_t *output, long int ns, unsigned char flag,
+		int width, int precision)
+{
+	static const unsigned long int unit[] = {1, 1000, 1000000, 1000000000};
+	static const char * const name[] = {"ns", "us", "ms", "s"};
+	unsigned long int mag = ns, s, big;
+	char text[48];
+	unsigned int n = 0, u, ret;
+
+	if (ns < 0)
+	{
+		mag = -mag;
+		text[n++] = '-';
+	}
+	s = mag / unit[3];
+	if (s < 60)
+	{
+		for (u = 0; u < 3 && mag >= unit[u + 1]; u++)
+			;
+		precision = (u == 0) ? 0 : (precision == -1) ? 1 :
+			(precision > 3) ? 3 : precision;
+		n += _scaled(text + n, mag, unit[u], precision);
+		memcpy(text + n, name[u], strlen(name[u]));
+		n += strlen(name[u]);
+	}
+	else
+	{
+		big = (s >= 86400) ? 86400 : (s >= 3600) ? 3600 : 60;
+		n += _scaled(text + n, s, big, 0);
+		text[n++] = (big == 86400) ? 'd' : (big == 3600) ? 'h' : 'm';
+		s = (s % big) / (big / ((big == 86400) ? 24 : 60));
+		text[n++] = '0' + s / 10;
+		text[n++] = '0' + s % 10;
+		text[n++] = (big == 86400) ? 'h' : (big == 3600) ? 'm' : 's';
+	}
+	ret = print_width(output, n, flag, width);
+	ret += _memcpy(output, text, n);
+	ret += neg_width(output, n, flag, width);
+	return (ret);
+}
@@ -0,0 +1,147 @@
+#define _GNU_SOURCE
+#include "main.h"
+#include <dlfcn.h>
+#include <stdio.h>
+
+int _ip_ok(const char *format);
+void *_ip_next(const char *name, void **slot);
+int _ip_format(char *dst, size_t size, const char *format, va_list ap);
+int vsnprintf(char *str, size_t size, const char *format, va_list ap);
+int snprintf(char *str, size_t size, const char *format, ...);
+
+/**
+ * _ip_ok - tells if a format only holds directives run prints exactly as
+ * glibc does: %% and c s p d i u o x X with the C flags, width and
+ * precision, h(h) or l(l) on the integers; anything else (positional args,
+ * floats, ' or custom specifiers) is left to glibc
+ * @format: format
+ *
+ * Return: 1 if the fast path may take it, else 0
+ */
+
+int _ip_ok(const char *format)
+{
+	const char *p = format;
+	int len;
+
+	while ((p = strchr(p, '%')) != NULL)
+	{
+		if (*++p == '%')
+		{
+			p++;
+			continue;
+		}
+		while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' ||
+				*p == '0')
+			p++;
+		if (*p == '*')
+			p++;
+		else
+			while (*p >= '0' && *p <= '9')
+				p++;
+		if (*p == '.' && *++p == '*')
+			p++;
+		else
+			while (*p >= '0' && *p <= '9')
+				p++;
+		len = (*p == 'h' || *p == 'l');
+		if (len && p[1] == *p)
+			len++;
+		p += len;
+		if (*p == '\0' || !strchr(len ? "diuoxX" : "diuoxXcsp", *p))
+			return (0);
+		p++;
+	}
+	return (1);
+}
+
+/**
+ * _ip_next - looks up the glibc definition an interposed function hides,
+ * once
+ * @name: function name
+ * @slot: where the address is kept between calls
+ *
+ * Return: address, NULL if there is none
+ */
+
+void *_ip_next(const char *name, void **slot)
+{
+	void *next = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+
+	if (next == NULL)
+	{
+		next = dlsym(RTLD_NEXT, name);
+		__atomic_store_n(slot, next, __ATOMIC_RELEASE);
+	}
+	return (next);
+}
+
+/**
+ * _ip_format - vsnprintf on run through a caller memory sink
+ * @dst: caller memory, may be NULL if size is 0
+ * @size: size of dst
+ * @format: format
+ * @ap: arg
+ *
+ * Return: no of characters the whole output takes, -1 on error
+ */
+
+int _ip_format(char *dst, size_t size, const char *format, va_list ap)
+{
+	char spare[1];
+	buffer_t *output;
+	int ret;
+
+	size = (size > UINT_MAX) ? UINT_MAX : size;
+	output = _sink_memory(size ? dst : spare, size ? size : 1);
+	if (output == NULL)
+		return (-1);
+	ret = run(format, ap, output);
+	_close(output);
+	free_buffer(output);
+	return (ret);
+}
+
+/**
+ * vsnprintf - interposes glibc vsnprintf, formats on run when it can
+ * @str: caller memory
+ * @size: size of str
+ * @format: format
+ * @ap: arg
+ *
+ * Return: no of characters the whole output takes, -1 on error
+ */
+
+int vsnprintf(char *str, size_t size, const char *format, va_list ap)
+{
+	static void *next;
+	union {
+		void *p;
+		int (*f)(char *, size_t, const char *, va_list);
+	} u;
+
+	if (_ip_ok(format))
+		return (_ip_format(str, size, format, ap));
+	u.p = _ip_next("vsnprintf", &next);
+	return ((u.p == NULL) ? -1 : u.f(str, size, format, ap));
+}
+
+/**
+ * snprintf - interposes glibc snprintf
+ * @str: caller memory
+ * @size: size of str
+ * @format: format
+ *
+ * Return: no of characters the whole output takes, -1 on error
+ */
+
+int snprintf(char *str, size_t size, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = vsnprintf(str, size, format, ap);
+	va_end(ap);
+	return (ret);
+}
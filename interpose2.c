@@ -0,0 +1,134 @@
+#define _GNU_SOURCE
+#include "main.h"
+#include <errno.h>
+#include <stdio.h>
+
+int _ip_write(FILE *stream, int fd, const char *format, va_list ap);
+int vprintf(const char *format, va_list ap);
+int printf(const char *format, ...);
+int vdprintf(int fd, const char *format, va_list ap);
+int dprintf(int fd, const char *format, ...);
+
+/**
+ * _ip_write - formats on run, on the stack when it fits, and writes the
+ * text to a stream (so it keeps its place among other stdio output) or
+ * to a file descriptor
+ * @stream: stream, NULL to write to fd
+ * @fd: file descriptor, used when stream is NULL
+ * @format: format, accepted by _ip_ok
+ * @ap: arg
+ *
+ * Return: no of characters written, -1 on error
+ */
+
+int _ip_write(FILE *stream, int fd, const char *format, va_list ap)
+{
+	char local[BUFF_SIZE], *text = local;
+	va_list again;
+	ssize_t w = 0;
+	int n, k;
+
+	va_copy(again, ap);
+	n = _ip_format(local, sizeof(local), format, ap);
+	if (n >= (int)sizeof(local))
+	{
+		text = malloc(n + 1);
+		if (text != NULL)
+			n = _ip_format(text, n + 1, format, again);
+		n = (text == NULL) ? -1 : n;
+	}
+	va_end(again);
+	if (n > 0 && stream != NULL && fwrite(text, 1, n, stream) != (size_t)n)
+		n = -1;
+	for (k = 0; n > 0 && stream == NULL && k < n; k += w)
+	{
+		w = write(fd, text + k, n - k);
+		w = (w < 0 && errno == EINTR) ? 0 : w;
+		n = (w < 0) ? -1 : n;
+	}
+	if (text != local)
+		free(text);
+	return (n);
+}
+
+/**
+ * vprintf - interposes glibc vprintf, formats on run when it can
+ * @format: format
+ * @ap: arg
+ *
+ * Return: no of characters written, -1 on error
+ */
+
+int vprintf(const char *format, va_list ap)
+{
+	static void *next;
+	union {
+		void *p;
+		int (*f)(const char *, va_list);
+	} u;
+
+	if (_ip_ok(format))
+		return (_ip_write(stdout, 1, format, ap));
+	u.p = _ip_next("vprintf", &next);
+	return ((u.p == NULL) ? -1 : u.f(format, ap));
+}
+
+/**
+ * printf - interposes glibc printf
+ * @format: format
+ *
+ * Return: no of characters written, -1 on error
+ */
+
+int printf(const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = vprintf(format, ap);
+	va_end(ap);
+	return (ret);
+}
+
+/**
+ * vdprintf - interposes glibc vdprintf, formats on run when it can
+ * @fd: file descriptor
+ * @format: format
+ * @ap: arg
+ *
+ * Return: no of characters written, -1 on error
+ */
+
+int vdprintf(int fd, const char *format, va_list ap)
+{
+	static void *next;
+	union {
+		void *p;
+		int (*f)(int, const char *, va_list);
+	} u;
+
+	if (_ip_ok(format))
+		return (_ip_write(NULL, fd, format, ap));
+	u.p = _ip_next("vdprintf", &next);
+	return ((u.p == NULL) ? -1 : u.f(fd, format, ap));
+}
+
+/**
+ * dprintf - interposes glibc dprintf
+ * @fd: file descriptor
+ * @format: format
+ *
+ * Return: no of characters written, -1 on error
+ */
+
+int dprintf(int fd, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = vdprintf(fd, format, ap);
+	va_end(ap);
+	return (ret);
+}
@@ -0,0 +1,172 @@
+#include "main.h"
+#include <time.h>
+
+int _printf_limit(unsigned long int rate, unsigned long int burst,
+		unsigned long int sample);
+limit_site_t *_site(const char *format);
+int _limited(const char *format);
+unsigned long int _limit_report(limit_site_t *site, int fd,
+		unsigned long int now);
+unsigned long int _printf_suppressed(int fd);
+
+static limit_site_t sites[LIMIT_SITES];
+static unsigned long int interval, tolerance, every;
+
+/**
+ * _printf_limit - limits every _printf call site, keyed by its format
+ * pointer, to rate lines a second after a burst, and keeps 1 in sample
+ * @rate: lines a second per call site, 0 for no limit
+ * @burst: lines a call site may print at once, 1 if 0
+ * @sample: keep 1 call in sample per call site, 0 or 1 keeps all
+ *
+ * Return: 0
+ */
+
+int _printf_limit(unsigned long int rate, unsigned long int burst,
+		unsigned long int sample)
+{
+	unsigned long int gap;
+
+	gap = (rate == 0) ? 0 : (rate >= 1000000000UL) ? 1 :
+		1000000000UL / rate;
+	burst = (burst == 0) ? 1 : burst;
+	__atomic_store_n(&tolerance, gap * (burst - 1), __ATOMIC_RELAXED);
+	__atomic_store_n(&every, (sample > 1) ? sample : 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&interval, gap, __ATOMIC_RELEASE);
+	return (0);
+}
+
+/**
+ * _site - finds the site of a format pointer, claiming a free slot for a
+ * new one; open addressing over LIMIT_PROBES slots, lock free
+ * @format: format pointer
+ *
+ * Return: site, NULL if its probes are all taken (the call is then not
+ * limited)
+ */
+
+limit_site_t *_site(const char *format)
+{
+	unsigned long int h = ((unsigned long int)format >> 3) *
+		0x9e3779b97f4a7c15UL;
+	const char *key;
+	unsigned int i, k;
+
+	for (i = 0; i < LIMIT_PROBES; i++)
+	{
+		k = ((h >> 54) + i) % LIMIT_SITES;
+		key = __atomic_load_n(&sites[k].key, __ATOMIC_ACQUIRE);
+		if (key == NULL && __atomic_compare_exchange_n(&sites[k].key,
+					&key, format, 0, __ATOMIC_ACQ_REL,
+					__ATOMIC_ACQUIRE))
+			return (&sites[k]);
+		if (key == format)
+			return (&sites[k]);
+	}
+	return (NULL);
+}
+
+/**
+ * _limited - decides if a _printf call is suppressed, before anything is
+ * parsed: sampling first, then a token bucket kept as the time it is next
+ * full enough for one call (GCRA) and moved on by compare and swap
+ * @format: format pointer
+ *
+ * Return: 1 to suppress the call, 0 to print it
+ */
+
+int _limited(const char *format)
+{
+	unsigned long int gap = __atomic_load_n(&interval, __ATOMIC_ACQUIRE);
+	unsigned long int n = __atomic_load_n(&every, __ATOMIC_RELAXED);
+	unsigned long int now, old, tat;
+	limit_site_t *site;
+	struct timespec ts;
+	int drop = 0;
+
+	if (gap == 0 && n == 0)
+		return (0);
+	site = _site(format);
+	if (site == NULL)
+		return (0);
+	if (n > 1 && __atomic_fetch_add(&site->seen, 1, __ATOMIC_RELAXED) % n)
+	{
+		__atomic_fetch_add(&site->dropped, 1, __ATOMIC_RELAXED);
+		return (1);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = ts.tv_sec * 1000000000UL + ts.tv_nsec;
+	_limit_report(site, 2, now);
+	old = __atomic_load_n(&site->tat, __ATOMIC_RELAXED);
+	while (gap != 0 && drop == 0)
+	{
+		tat = (old > now) ? old : now;
+		if (tat - now > __atomic_load_n(&tolerance, __ATOMIC_RELAXED))
+			drop = 1;
+		else if (__atomic_compare_exchange_n(&site->tat, &old,
+					tat + gap, 1, __ATOMIC_RELAXED,
+					__ATOMIC_RELAXED))
+			break;
+	}
+	if (drop)
+		__atomic_fetch_add(&site->dropped, 1, __ATOMIC_RELAXED);
+	return (drop);
+}
+
+/**
+ * _limit_report - writes how many calls of a site were suppressed since
+ * its last report, at most once every LIMIT_REPORT ns per site, counted
+ * from its first suppressed call
+ * @site: site
+ * @fd: file descriptor
+ * @now: monotonic time in ns, 0 to report whatever the time
+ *
+ * Return: no of suppressed calls reported
+ */
+
+unsigned long int _limit_report(limit_site_t *site, int fd,
+		unsigned long int now)
+{
+	unsigned long int last = __atomic_load_n(&site->reported,
+			__ATOMIC_RELAXED), count;
+	printf_ctx_t *ctx;
+
+	if (__atomic_load_n(&site->dropped, __ATOMIC_RELAXED) == 0)
+		return (0);
+	if (now != 0 && last == 0)
+		__atomic_compare_exchange_n(&site->reported, &last, now, 0,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED);
+	if (now != 0 && now - last < LIMIT_REPORT)
+		return (0);
+	if (now != 0 && !__atomic_compare_exchange_n(&site->reported, &last,
+				now, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		return (0);
+	count = __atomic_exchange_n(&site->dropped, 0, __ATOMIC_RELAXED);
+	ctx = (count > 0) ? _ctx_open(fd, 256) : NULL;
+	if (ctx != NULL)
+	{
+		_cprintf(ctx, "_printf: suppressed %lu calls of \"%S\"\n",
+				count, site->key);
+		_ctx_close(ctx);
+	}
+	return (count);
+}
+
+/**
+ * _printf_suppressed - reports the calls suppressed at every site since
+ * their last report, eg from a timer or before exit
+ * @fd: file descriptor the reports go to
+ *
+ * Return: no of suppressed calls reported
+ */
+
+unsigned long int _printf_suppressed(int fd)
+{
+	unsigned long int total = 0;
+	unsigned int k;
+
+	for (k = 0; k < LIMIT_SITES; k++)
+		if (__atomic_load_n(&sites[k].key, __ATOMIC_ACQUIRE) != NULL)
+			total += _limit_report(&sites[k], fd, 0);
+	return (total);
+}
@@ -164,6 +164,15 @@ int main(void)
 	_printf("Non-printable chars: %S\n", "Hello\nWorld\x01\x7F");
 	_printf("\n");
 
+	/* Wide character tests */
+	_printf("┌─ WIDE CHARACTER TESTS ────────────────────────────────┐\n");
+	_printf("Wide char: %lc\n", 0x263A);
+	_printf("Wide string: %ls\n", L"日本語 – wörld");
+	_printf_width_mode(WIDTH_COLUMNS);
+	_printf("Width 10 in columns: |%10s|\n", "日本");
+	_printf_width_mode(WIDTH_BYTES);
+	_printf("\n");
+
 	/* Mixed format tests */
 	_printf("┌─ MIXED FORMAT TESTS ──────────────────────────────────┐\n");
 	_printf("Name: %s, Age: %d, Score: %u\n", "Alice", 25, 95);
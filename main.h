@@ -2,9 +2,12 @@
 #define MAIN_H
 
 #include <limits.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <wchar.h>
 
 /* flag macros */
 #define PLUS 1
@@ -12,30 +15,402 @@
 #define HASH 4
 #define ZERO 8
 #define NEG 16
+#define GROUP 64
 #define PLUS_FLAG (flag & 1)
 #define SPACE_FLAG ((flag >> 1) & 1)
 #define HASH_FLAG ((flag >> 2) & 1)
 #define ZERO_FLAG ((flag >> 3) & 1)
 #define NEG_FLAG ((flag >> 4) & 1)
+#define GROUP_FLAG ((flag >> 6) & 1)
+
+/* output buffer size */
+#define BUFF_SIZE 1024
+
+/* string width modes, see _printf_width_mode */
+#define WIDTH_BYTES 0
+#define WIDTH_POINTS 1
+#define WIDTH_COLUMNS 2
+
+/* maplog policies, see _maplog_open */
+#define MAPLOG_SEQUENTIAL 1
+#define MAPLOG_DROP 2
+
+/* non-blocking stream sink modes, see sink_nb.c */
+#define NB_REAL 0
+#define NB_SKIP 1
+#define NB_DROP 2
+#define NB_SPILL 64
+
+/* most buffers an io_uring sink queues, see _sink_uring */
+#define RING_DEPTH 8
+
+/* call-site limits, see _printf_limit */
+#define LIMIT_SITES 1024
+#define LIMIT_PROBES 8
+#define LIMIT_REPORT 1000000000UL
+
+/* longest record _sink_coalesce compares, longer ones always print */
+#define COALESCE_MAX 1024
+
+/* clocks %T reads, see _printf_clock */
+#define STAMP_FINE 0
+#define STAMP_COARSE 1
+
+/* shared buffer of _printf_buffered */
+#define DEFER_SIZE 65536
+
+/* why a buffer was written out, see printf_stats_t */
+#define FLUSH_FULL 0
+#define FLUSH_EXPLICIT 1
+#define FLUSH_END 2
+#define FLUSH_GROW 3
+#define FLUSH_REASONS 4
+
+/* counter only its own thread writes, other threads may read it */
+#define STAT_ADD(x, n) __atomic_store_n(&(x), (x) + (n), __ATOMIC_RELAXED)
 
 /* Length Modifier Macros */
 #define SHORT 1
 #define LONG 2
+#define CHAR 3
+
+
+struct buffer_s;
 
+/**
+ * struct sink_s - output backend behind a buffer_t, ops but reserve may
+ * be NULL
+ * @reserve: called when the buffer is full, must leave room for a byte
+ * @commit: called when a formatted call (a record) is complete
+ * @flush: pushes buffered bytes to the destination
+ * @close: final flush, releases the destination
+ * @grows: 1 if reserve makes room in memory, growing or spilling the
+ * buffer, instead of writing it out
+ */
+typedef struct sink_s
+{
+	int (*reserve)(struct buffer_s *output);
+	int (*commit)(struct buffer_s *output);
+	int (*flush)(struct buffer_s *output);
+	int (*close)(struct buffer_s *output);
+	int grows;
+} sink_t;
 
  /**
  * struct buffer_s - type def buffer struct
  * @buffer: char array pointer
- * @start: start buffer pointer
+ * @start: start buffer pointer, freed by free_buffer unless the sink
+ * set it to NULL on close
  * @len: length
+ * @size: capacity of start
+ * @fd: file descriptor flushed to
+ * @flushes: no of flushes issued
+ * @error: set once the sink failed, later bytes may be dropped
+ * @sink: backend ops
+ * @data: backend state
+ * @high: most bytes held when the buffer was written out
+ * @flushed: no of times it was written out, by FLUSH_ reason, or grew
+ * in memory (FLUSH_GROW)
  */
 typedef struct buffer_s
 {
 	char *buffer;
 	char *start;
 	unsigned int len;
+	unsigned int size;
+	int fd;
+	unsigned long int flushes;
+	int error;
+	const sink_t *sink;
+	void *data;
+	unsigned int high;
+	unsigned long int flushed[FLUSH_REASONS];
 } buffer_t;
 
+/**
+ * struct maplog_s - append-only log file shared by many buffers/threads
+ * @fd: log file
+ * @map: mapping of the whole address range the log may grow to
+ * @limit: size of that range
+ * @tail: next free offset, advanced by compare and swap, never past limit
+ * @length: file length, extended lazily in steps
+ * @step: bytes added per extension
+ * @synced: offset up to which msync was issued
+ * @sync_every: bytes between MS_ASYNC writebacks, 0 for never
+ * @policy: MAPLOG_SEQUENTIAL and/or MAPLOG_DROP
+ * @lock: held only while extending the file
+ */
+typedef struct maplog_s
+{
+	int fd;
+	char *map;
+	unsigned long int limit;
+	unsigned long int tail;
+	unsigned long int length;
+	unsigned long int step;
+	unsigned long int synced;
+	unsigned long int sync_every;
+	int policy;
+	pthread_mutex_t lock;
+} maplog_t;
+
+/**
+ * struct uring_s - state of an io_uring sink
+ * @ring: io_uring file descriptor
+ * @rings: shared submission and completion rings
+ * @rings_size: size of the rings mapping
+ * @sqes: submission queue entries
+ * @sqes_size: size of the sqes mapping
+ * @sq_tail: submission tail, written by us
+ * @sq_mask: submission ring mask
+ * @sq_array: submission index array
+ * @cq_head: completion head, written by us
+ * @cq_tail: completion tail, written by the kernel
+ * @cq_mask: completion ring mask
+ * @cqes: completion queue entries
+ * @block: depth buffers of size bytes each
+ * @depth: no of buffers
+ * @slot: buffer being formatted into
+ * @inflight: no of buffers queued to the kernel
+ * @pending: bytes queued per buffer, 0 once it is free
+ * @off: file offset the next buffer is written at, -1 for a pipe, socket
+ * or O_APPEND file, which is written at its own position in order
+ * @at: file offset each queued buffer is written at, -1 as for off
+ */
+typedef struct uring_s
+{
+	int ring;
+	char *rings;
+	unsigned long int rings_size;
+	struct io_uring_sqe *sqes;
+	unsigned long int sqes_size;
+	unsigned int *sq_tail;
+	unsigned int *sq_mask;
+	unsigned int *sq_array;
+	unsigned int *cq_head;
+	unsigned int *cq_tail;
+	unsigned int *cq_mask;
+	struct io_uring_cqe *cqes;
+	char *block;
+	unsigned int depth;
+	unsigned int slot;
+	unsigned int inflight;
+	unsigned int pending[RING_DEPTH];
+	long int off;
+	long int at[RING_DEPTH];
+} uring_t;
+
+/**
+ * struct fmt_op_s - one directive of a compiled format
+ * @text: literal text stored before the directive
+ * @n: length of text
+ * @spec: conversion specifier, 0 for the text after the last directive
+ * @flag: flags
+ * @len: length modifier
+ * @width: width
+ * @precision: prec, -1 if none
+ */
+typedef struct fmt_op_s
+{
+	const char *text;
+	unsigned int n;
+	char spec;
+	unsigned char flag;
+	unsigned char len;
+	int width;
+	int precision;
+} fmt_op_t;
+
+/**
+ * struct allocator_s - caller supplied allocator
+ * @alloc: returns size bytes, NULL on failure
+ * @arg: passed back to alloc
+ */
+typedef struct allocator_s
+{
+	void *(*alloc)(void *arg, unsigned long int size);
+	void *arg;
+} allocator_t;
+
+/**
+ * struct arena_s - bump allocator freed in one go by _arena_free
+ * @alloc: allocator handing out arena memory
+ * @block: current block, linked to the blocks before it
+ * @used: bytes used in the current block
+ * @size: bytes per block
+ */
+typedef struct arena_s
+{
+	allocator_t alloc;
+	char *block;
+	unsigned long int used;
+	unsigned long int size;
+} arena_t;
+
+/**
+ * struct printf_ctx_s - output context reused across many calls
+ * @output: buffer kept between calls, flushed when full
+ * @calls: no of calls formatted
+ * @bytes: no of bytes formatted
+ */
+typedef struct printf_ctx_s
+{
+	buffer_t *output;
+	unsigned long int calls;
+	unsigned long int bytes;
+} printf_ctx_t;
+
+/**
+ * struct nbstream_s - resumable formatter over a non-blocking descriptor
+ * @output: buffer, its sink writes without ever waiting
+ * @ops: compiled format of the saved batch, NULL when there is none
+ * @records: records of the saved batch
+ * @count: no of records
+ * @stride: bytes from one record to the next
+ * @describe: field offset of each directive but %%
+ * @row: record being stored
+ * @piece: text (even) or field (odd) of directive piece / 2 being stored
+ * @field: index in describe of that field
+ * @skip: bytes of the piece stored before the stall
+ * @sent: bytes written so far
+ * @mode: NB_REAL, NB_SKIP or NB_DROP
+ * @kept: length of the buffer while the sink stores to spill
+ * @left: bytes still to skip
+ * @grant: bytes of spill handed out by the last reserve
+ * @spill: scratch that skipped and dropped bytes go to
+ */
+typedef struct nbstream_s
+{
+	buffer_t *output;
+	const fmt_op_t *ops;
+	const char *records;
+	unsigned long int count;
+	unsigned long int stride;
+	const unsigned long int *describe;
+	unsigned long int row;
+	unsigned int piece;
+	unsigned int field;
+	unsigned long int skip;
+	unsigned long int sent;
+	int mode;
+	unsigned int kept;
+	unsigned long int left;
+	unsigned int grant;
+	char spill[NB_SPILL];
+} nbstream_t;
+
+/**
+ * struct limit_site_s - rate limit and sampling state of a _printf call
+ * site
+ * @key: format pointer of the site, NULL while the slot is free
+ * @tat: when its bucket next holds a whole token, in ns
+ * @seen: no of calls seen, for sampling
+ * @dropped: no of calls suppressed since the last report
+ * @reported: when suppressed calls were last reported, in ns
+ */
+typedef struct limit_site_s
+{
+	const char *key;
+	unsigned long int tat;
+	unsigned long int seen;
+	unsigned long int dropped;
+	unsigned long int reported;
+} limit_site_t;
+
+/**
+ * struct coalesce_s - state of a sink collapsing repeated records
+ * @lock: held by the sink ops of shared state
+ * @shared: set for the state all _printf calls share, which writes each
+ * record out as soon as it is committed
+ * @mark: offset in the buffer where the record in progress starts
+ * @at: flushes of the buffer when it started, a record written out in
+ * part is never dropped
+ * @hash: hash of the last record
+ * @n: length of the last record, -1 if nothing can match it
+ * @repeats: no of copies of the last record dropped and not reported
+ * @last: the last record
+ */
+typedef struct coalesce_s
+{
+	pthread_mutex_t lock;
+	int shared;
+	unsigned int mark;
+	unsigned long int at;
+	unsigned long int hash;
+	int n;
+	unsigned long int repeats;
+	char last[COALESCE_MAX];
+} coalesce_t;
+
+/**
+ * struct deferred_s - buffer all _printf calls share while
+ * _printf_buffered is on
+ * @lock: guards the rest
+ * @wake: tells the flush thread the buffer stopped being empty, or the
+ * deadline changed
+ * @deadline: ns the oldest byte may wait, 0 when off
+ * @oldest: when the oldest byte came, in ns
+ * @len: no of bytes held
+ * @data: the bytes
+ */
+typedef struct deferred_s
+{
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	unsigned long int deadline;
+	unsigned long int oldest;
+	unsigned int len;
+	char data[DEFER_SIZE];
+} deferred_t;
+
+/**
+ * struct printf_stats_s - formatter memory and flush counters of one
+ * thread, or summed over all of them
+ * @live: bytes the pool handed out and did not get back; a block freed by
+ * another thread than the one that took it counts there
+ * @cached: bytes kept on the pool's free lists
+ * @high: most bytes a buffer held when it was written out
+ * @flushed: no of buffer writes, by FLUSH_ reason, and of in-memory
+ * growths as FLUSH_GROW
+ */
+typedef struct printf_stats_s
+{
+	long int live;
+	long int cached;
+	unsigned long int high;
+	unsigned long int flushed[FLUSH_REASONS];
+} printf_stats_t;
+
+/**
+ * struct stats_node_s - counters of a thread, linked while it runs
+ * @st: counters
+ * @on: 1 while linked, -1 if they can't be, 0 before first use
+ * @next: next thread
+ * @prev: previous thread
+ */
+typedef struct stats_node_s
+{
+	printf_stats_t st;
+	int on;
+	struct stats_node_s *next;
+	struct stats_node_s *prev;
+} stats_node_t;
+
+/**
+ * struct stamp_s - per thread cache of a timestamp up to the second
+ * @sec: second the text is for, -1 before the first timestamp
+ * @zn: length of the zone suffix
+ * @zone: zone suffix, Z or an offset like +02:00
+ * @text: YYYY-MM-DDTHH:MM:SS. of that second
+ */
+typedef struct stamp_s
+{
+	long int sec;
+	unsigned int zn;
+	char zone[8];
+	char text[24];
+} stamp_t;
+
 /**
  * struct flag_s - typr def for flags struct
  * @flag: char repflag
@@ -85,6 +460,74 @@ unsigned int _r(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len);
 unsigned int _R(va_list ap, buffer_t *output, unsigned char flag,
 		int width, int precision, unsigned char len);
+unsigned int _json(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _logfmt(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _bytes(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _duration(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _timestamp(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _wchar(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _wstring(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+
+/* value cores */
+unsigned int _vchar(buffer_t *output, char c, unsigned char flag, int width);
+unsigned int _vstr(buffer_t *output, const char *str, unsigned char flag,
+		int width, int precision);
+unsigned int _vint(buffer_t *output, long int d, unsigned char flag,
+		int width, int precision);
+unsigned int _vuint(buffer_t *output, unsigned long int num, char spec,
+		unsigned char flag, int width, int precision);
+unsigned int _vjson(buffer_t *output, const char *str, char spec,
+		int precision);
+unsigned int _utoa(char *dst, unsigned long int num);
+unsigned int _vdec(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width);
+unsigned int _group(char *dst, unsigned long int num);
+unsigned int _vgroup(buffer_t *output, long int d, char spec,
+		unsigned char flag, int width, int precision);
+unsigned int _scaled(char *dst, unsigned long int num, unsigned long int unit,
+		int decimals);
+unsigned int _vbytes(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision);
+unsigned int _vdur(buffer_t *output, long int ns, unsigned char flag,
+		int width, int precision);
+int _printf_bin_group(int bits);
+unsigned long int _bit_chars(unsigned int byte);
+unsigned int _bits(char *dst, unsigned long int num, unsigned int n);
+unsigned int _bin_group(char *dst, unsigned long int num, int n,
+		int precision);
+unsigned int _vbin(buffer_t *output, unsigned long int num,
+		unsigned char flag, int width, int precision);
+int _printf_clock(int clock);
+unsigned int _stamp_second(stamp_t *st, long int sec, int utc);
+unsigned int _stamp(char *dst, int utc, int digits);
+unsigned int _vtime(buffer_t *output, unsigned char flag, int width,
+		int precision);
+
+/* plain converters, no flag, width or precision */
+unsigned int (*_plain(const char *spec, unsigned char len,
+		unsigned int (*f)(va_list, buffer_t *, unsigned char, int,
+			int, unsigned char)))(va_list, buffer_t *,
+		unsigned char, int, int, unsigned char);
+unsigned int _plain_int(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_dec(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_hex(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_HEX(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_string(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _kdec(buffer_t *output, unsigned long int num, int neg);
+unsigned int _khex(buffer_t *output, unsigned long int num,
+		const char *digits);
 
 /* handler */
 unsigned char _flag(const char *flag, char *i);
@@ -104,14 +547,162 @@ unsigned int neg_width(buffer_t *output, unsigned int printed,
 		unsigned char flag, int width);
 
 /* helper fn */
-buffer_t *init_buffer(void);
+buffer_t *_buffer(char *start, unsigned int size, const sink_t *sink,
+		void *data);
+buffer_t *init_buffer(int fd, unsigned int size);
 void free_buffer(buffer_t *output);
 unsigned int _memcpy(buffer_t *output, const char *src, unsigned int n);
-unsigned int _sbase(buffer_t *output, long int num, char *base,
-		 unsigned char flag, int width, int precision);
-unsigned int _ubase(buffer_t *output, unsigned long int num, char *base,
-		unsigned char flag, int width, int precision);
+char *_reserve(buffer_t *output, unsigned int *n);
+unsigned int _commit(buffer_t *output, unsigned int n);
+int _flush(buffer_t *output);
+int _fd_flush(buffer_t *output);
+int _close(buffer_t *output);
+int _trim(buffer_t *output);
+void _account(buffer_t *output, int why);
+int _record(buffer_t *output);
+
+/* sinks */
+buffer_t *_sink_string(unsigned int size);
+buffer_t *_sink_memory(char *mem, unsigned int size);
+int _grow(buffer_t *output);
+buffer_t *_sink_mmap(const char *path, unsigned int size);
+buffer_t *_sink_callback(int (*fn)(void *, const char *, unsigned int),
+		void *arg, unsigned int size);
+maplog_t *_maplog_open(const char *path, unsigned long int limit,
+		unsigned long int step, unsigned long int sync_every,
+		int policy);
+int _maplog_close(maplog_t *log);
+buffer_t *_sink_maplog(maplog_t *log, unsigned int size);
+long int _log_claim(maplog_t *log, unsigned int n);
+int _log_append(buffer_t *output);
+int _log_grow(buffer_t *output);
+buffer_t *_sink_uring(int fd, unsigned int size, unsigned int depth);
+int _ring_setup(uring_t *u, unsigned int entries);
+int _ring_probe(int ring);
+long int _ring_finish(buffer_t *output, unsigned int slot, long int done);
+nbstream_t *_nb_open(int fd, unsigned int size);
+int _nb_write(buffer_t *output);
+int _nb_reserve(buffer_t *output);
+void _nb_skip(nbstream_t *nb, unsigned long int skip);
+int _nb_settle(nbstream_t *nb, unsigned long int mark);
+
+/* batches */
+fmt_op_t *_printf_compile(const char *format);
+int _compile_spec(fmt_op_t *op, const char *format, ...);
+long int _printf_batch(const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe);
+long int _ctx_batch(printf_ctx_t *ctx, const fmt_op_t *ops,
+		const void *records, unsigned long int count,
+		unsigned long int stride, const unsigned long int *describe);
+unsigned int _batch_field(buffer_t *output, const fmt_op_t *op,
+		const char *field);
+long int _printf_parallel(int fd, const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe, unsigned int workers);
+long int _ctx_column(printf_ctx_t *ctx, const char *format,
+		const void *values, unsigned long int count);
+int _nb_batch(nbstream_t *nb, const fmt_op_t *ops, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe);
+int _nb_resume(nbstream_t *nb);
+int _nb_close(nbstream_t *nb);
+int _nb_run(nbstream_t *nb);
+
+/* memory pool */
+void _printf_allocator(void *(*alloc)(size_t), void (*release)(void *));
+void *_pool_get(unsigned long int size);
+void _pool_put(void *ptr, unsigned long int size);
+void _pool_drain(void *unused);
+long int _printf_pool_cap(long int bytes);
+
+/* memory and flush stats */
+printf_stats_t *_stats_self(void);
+void _stats_exit(void *unused);
+void _stats_add(printf_stats_t *to, const printf_stats_t *from);
+int _printf_stats(printf_stats_t *st, int all);
 
+/* allocated strings */
+int _asprintf(char **strp, const char *format, ...);
+int _vasprintf(char **strp, const char *format, va_list ap);
+int _asprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, ...);
+int _vasprintf_alloc(const allocator_t *alloc, char **strp,
+		const char *format, va_list ap);
+arena_t *_arena(unsigned long int block);
+void *_arena_alloc(void *arena, unsigned long int size);
+void _arena_free(arena_t *arena);
+
+unsigned int _digits(char *dst, unsigned long int num, char spec);
+unsigned int _fill(buffer_t *output, char c, int count);
+unsigned int _vnum(buffer_t *output, const char *digits, int n,
+		const char *lead, unsigned char flag, int width, int precision);
+
+/* simd kernels */
+unsigned int _print_span(const char *str, unsigned int n);
+void _rot13(char *dst, const char *src, unsigned int n);
+void _reverse(char *dst, const char *src, unsigned int n);
+unsigned int _strput(buffer_t *output, const char *str, unsigned int max);
+unsigned int _escape(buffer_t *output, const char *str, unsigned int n);
+unsigned int _quote_span(const char *str, unsigned int n, unsigned char below,
+		const char *stop);
+unsigned int _jescape(buffer_t *output, const char *str, unsigned int n);
+unsigned int _jstring(buffer_t *output, const char *str, unsigned int max);
+
+/* utf-8 and display width */
+int _printf_width_mode(int mode);
+unsigned int _ucols(unsigned long int cp);
+unsigned int _udecode(const char *str, unsigned int n, unsigned long int *cp);
+unsigned int _measure(const char *str, unsigned int max, int width);
+unsigned int _utf8(char *dst, unsigned long int cp);
+unsigned int _wmeasure(const wchar_t *str, unsigned int max, int width);
+unsigned int _wwindow(char *dst, unsigned int n, const wchar_t **str,
+		unsigned int cnt, char *utf, unsigned int *k);
+unsigned int _wput(buffer_t *output, const wchar_t *str, unsigned int max);
+
+int run(const char *format, va_list ap, buffer_t *output);
 int _printf(const char *format, ...);
+int _vprintf(const char *format, va_list ap);
+int _printf_limit(unsigned long int rate, unsigned long int burst,
+		unsigned long int sample);
+limit_site_t *_site(const char *format);
+int _limited(const char *format);
+unsigned long int _limit_report(limit_site_t *site, int fd,
+		unsigned long int now);
+unsigned long int _printf_suppressed(int fd);
+buffer_t *_co_buffer(int fd, unsigned int size, coalesce_t *co);
+int _co_commit(buffer_t *output);
+int _co_flush(buffer_t *output);
+int _co_close(buffer_t *output);
+int _co_write(buffer_t *output, int summary);
+buffer_t *_sink_coalesce(int fd, unsigned int size);
+int _printf_coalesce(int on);
+buffer_t *_printf_buffer(void);
+void _co_exit(void);
+unsigned long int _co_hash(const char *s, unsigned int n);
+long int _printf_buffered(long int ms);
+buffer_t *_dl_buffer(void);
+int _dl_commit(buffer_t *output);
+int _dl_write(int fd, const char *s, unsigned int n);
+int _printf_flush(void);
+int _dl_start(deferred_t *d);
+void *_dl_thread(void *arg);
+void _dl_fatal(int sig);
+void _dl_exit(void);
+unsigned long int _dl_now(void);
+
+/* LD_PRELOAD interposer, libprintf_preload.so only */
+int _ip_ok(const char *format);
+void *_ip_next(const char *name, void **slot);
+int _ip_format(char *dst, size_t size, const char *format, va_list ap);
+
+/* reusable context */
+printf_ctx_t *_ctx_open(int fd, unsigned int capacity);
+printf_ctx_t *_ctx_sink(buffer_t *output);
+int _cprintf(printf_ctx_t *ctx, const char *format, ...);
+int _vcprintf(printf_ctx_t *ctx, const char *format, va_list ap);
+int _ctx_flush(printf_ctx_t *ctx);
+int _ctx_close(printf_ctx_t *ctx);
+int _ctx_trim(printf_ctx_t *ctx);
 
 #endif
@@ -0,0 +1,153 @@
+#include "main.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+maplog_t *_maplog_open(const char *path, unsigned long int limit,
+		unsigned long int step, unsigned long int sync_every,
+		int policy);
+int _maplog_close(maplog_t *log);
+buffer_t *_sink_maplog(maplog_t *log, unsigned int size);
+long int _log_claim(maplog_t *log, unsigned int n);
+int _log_append(buffer_t *output);
+int _log_grow(buffer_t *output);
+
+static const sink_t maplog_sink = {_log_grow, _log_append, _log_append,
+	_log_append, 1};
+
+/**
+ * _maplog_open - opens an append-only log that buffers copy records into
+ * with plain stores; the whole address range is mapped up front and the
+ * file is extended under it in large ftruncate steps
+ * @path: log file, appended to if it exists
+ * @limit: max log size, 1 GiB if 0
+ * @step: extension step, 8 MiB if 0
+ * @sync_every: bytes between MS_ASYNC writebacks, 0 for never
+ * @policy: MAPLOG_SEQUENTIAL to madvise sequential access, MAPLOG_DROP to
+ * drop written back pages from the mapping
+ *
+ * Return: pointer to the log, NULL on failure
+ */
+
+maplog_t *_maplog_open(const char *path, unsigned long int limit,
+		unsigned long int step, unsigned long int sync_every,
+		int policy)
+{
+	maplog_t *log;
+	struct stat st;
+
+	log = _pool_get(sizeof(maplog_t));
+	if (log == NULL)
+		return (NULL);
+	log->limit = (limit == 0) ? 1UL << 30 : limit;
+	log->step = (step == 0) ? 8UL << 20 : step;
+	log->sync_every = sync_every;
+	log->policy = policy;
+	log->map = MAP_FAILED;
+	log->fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (log->fd >= 0 && fstat(log->fd, &st) == 0 &&
+			(unsigned long int)st.st_size < log->limit)
+		log->map = mmap(NULL, log->limit, PROT_READ | PROT_WRITE,
+				MAP_SHARED, log->fd, 0);
+	if (log->map == MAP_FAILED)
+	{
+		if (log->fd >= 0)
+			close(log->fd);
+		_pool_put(log, sizeof(maplog_t));
+		return (NULL);
+	}
+	if (policy & MAPLOG_SEQUENTIAL)
+		madvise(log->map, log->limit, MADV_SEQUENTIAL);
+	log->tail = log->length = log->synced = st.st_size;
+	pthread_mutex_init(&log->lock, NULL);
+	return (log);
+}
+
+/**
+ * _maplog_close - trims the file to the bytes appended and unmaps it,
+ * every buffer on the log must be closed first
+ * @log: log
+ *
+ * Return: 0, -1 on error
+ */
+
+int _maplog_close(maplog_t *log)
+{
+	int ret = 0;
+
+	if (log == NULL)
+		return (-1);
+	if (log->tail > log->limit)
+		log->tail = log->limit;
+	if (msync(log->map, log->tail, MS_ASYNC) < 0 ||
+			ftruncate(log->fd, log->tail) < 0)
+		ret = -1;
+	munmap(log->map, log->limit);
+	close(log->fd);
+	pthread_mutex_destroy(&log->lock);
+	_pool_put(log, sizeof(maplog_t));
+	return (ret);
+}
+
+/**
+ * _sink_maplog - buffer appending each record to a log, one per thread
+ * @log: log shared by the buffers
+ * @size: initial staging capacity, doubled for longer records so every
+ * record is appended whole, BUFF_SIZE * 16 if 0
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_maplog(maplog_t *log, unsigned int size)
+{
+	buffer_t *output;
+	char *start;
+
+	if (log == NULL)
+		return (NULL);
+	size = (size == 0) ? BUFF_SIZE * 16 : size;
+	start = _pool_get(size);
+	if (start == NULL)
+		return (NULL);
+	output = _buffer(start, size, &maplog_sink, log);
+	if (output == NULL)
+		_pool_put(start, size);
+	return (output);
+}
+
+/**
+ * _log_claim - claims n bytes at the tail; the file is extended first,
+ * under the lock, so a claim is only published once its bytes exist
+ * @log: log
+ * @n: no of bytes
+ *
+ * Return: offset of the claimed bytes, -1 once the log is full or the
+ * file can't grow
+ */
+
+long int _log_claim(maplog_t *log, unsigned int n)
+{
+	unsigned long int off, end, length;
+
+	off = __atomic_load_n(&log->tail, __ATOMIC_RELAXED);
+	do {
+		end = off + n;
+		if (end > log->limit)
+			return (-1);
+		if (end <= __atomic_load_n(&log->length, __ATOMIC_ACQUIRE))
+			continue;
+		pthread_mutex_lock(&log->lock);
+		for (length = log->length; length < end; length += log->step)
+			;
+		length = (length > log->limit) ? log->limit : length;
+		if (length != log->length && ftruncate(log->fd, length) == 0)
+			__atomic_store_n(&log->length, length,
+					__ATOMIC_RELEASE);
+		length = log->length;
+		pthread_mutex_unlock(&log->lock);
+		if (end > length)
+			return (-1);
+	} while (!__atomic_compare_exchange_n(&log->tail, &off, end, 1,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	return ((long int)off);
+}
@@ -0,0 +1,70 @@
+#include "main.h"
+#include <sys/mman.h>
+
+int _log_append(buffer_t *output);
+int _log_grow(buffer_t *output);
+
+/**
+ * _log_append - copies the buffered record to the log and applies the
+ * writeback policy; once a record was dropped nothing more is appended
+ * @output: struct
+ *
+ * Return: no of bytes appended, -1 if the log is full or a record was
+ * dropped
+ */
+
+int _log_append(buffer_t *output)
+{
+	maplog_t *log = output->data;
+	unsigned long int page = 4096, from, to;
+	long int off;
+	int n = output->len;
+
+	output->buffer = output->start;
+	output->len = 0;
+	if (output->error)
+		return (-1);
+	if (n == 0)
+		return (0);
+	off = _log_claim(log, n);
+	if (off < 0)
+	{
+		output->error = 1;
+		return (-1);
+	}
+	memcpy(log->map + off, output->start, n);
+	output->flushes++;
+	from = __atomic_load_n(&log->synced, __ATOMIC_RELAXED);
+	to = (off + n) & ~(page - 1);
+	if (log->sync_every == 0 || to < from + log->sync_every ||
+			!__atomic_compare_exchange_n(&log->synced, &from, to, 0,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		return (n);
+	from &= ~(page - 1);
+	msync(log->map + from, to - from, MS_ASYNC);
+	if (log->policy & MAPLOG_DROP)
+		madvise(log->map + from, to - from, MADV_DONTNEED);
+	return (n);
+}
+
+/**
+ * _log_grow - the staging buffer is full in the middle of a record,
+ * doubles it rather than append part of the record, which other threads'
+ * records could then interleave with; a record that can't grow (out of
+ * memory, or longer than the log) is dropped and the error flag set
+ * @output: struct
+ *
+ * Return: 0, -1 if the record was dropped
+ */
+
+int _log_grow(buffer_t *output)
+{
+	maplog_t *log = output->data;
+
+	if (output->size < log->limit && _grow(output) == 0)
+		return (0);
+	output->error = 1;
+	output->buffer = output->start;
+	output->len = 0;
+	return (-1);
+}
@@ -35,7 +35,7 @@ unsigned int neg_width(buffer_t *output, unsigned int printed,
 * @flag: flag
 * @width: width
 * @precision: prec
-* @size: size of string
+* @size: size of string, may be bounded by width or precision
 * Return: no of bytes stored to buffer
 */
 unsigned int string_width(buffer_t *output, unsigned char flag,
@@ -46,7 +46,9 @@ unsigned int string_width(buffer_t *output, unsigned char flag,
 
 	if (NEG_FLAG == 0)
 	{
-		width -= (precision == -1) ? size : precision;
+		if (precision == -1 || precision > size)
+			precision = size;
+		width -= precision;
 		for (; width > 0; width--)
 			ret += _memcpy(output, &wid, 1);
 	}
@@ -69,7 +71,7 @@ unsigned int print_width(buffer_t *output, unsigned int printed,
 
 	if (NEG_FLAG == 0)
 	{
-		for (width -= printed; width > 0; )
+		for (width -= printed; width > 0; width--)
 			ret += _memcpy(output, &wid, 1);
 	}
 	return (ret);
@@ -0,0 +1,129 @@
+#include "main.h"
+
+int _nb_batch(nbstream_t *nb, const fmt_op_t *ops, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe);
+int _nb_resume(nbstream_t *nb);
+int _nb_close(nbstream_t *nb);
+int _nb_run(nbstream_t *nb);
+
+/**
+ * _nb_batch - formats records like _ctx_batch without ever blocking; when
+ * the descriptor would block the position is saved and formatting goes on
+ * from there in _nb_resume, ops and records must stay untouched till then
+ * @nb: stream
+ * @ops: from _printf_compile
+ * @records: array of records
+ * @count: no of records
+ * @stride: bytes from one record to the next
+ * @describe: field offset of each directive but %%
+ *
+ * Return: 0 once all is written, 1 to call _nb_resume when the descriptor
+ * is writable, -1 on error or while an earlier batch is saved
+ */
+
+int _nb_batch(nbstream_t *nb, const fmt_op_t *ops, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe)
+{
+	if (nb == NULL || ops == NULL || nb->ops != NULL || nb->output->error ||
+			(count > 0 && records == NULL))
+		return (-1);
+	nb->ops = ops;
+	nb->records = records;
+	nb->count = count;
+	nb->stride = stride;
+	nb->describe = describe;
+	nb->row = 0;
+	nb->piece = 0;
+	nb->field = 0;
+	nb->skip = 0;
+	return (_nb_run(nb));
+}
+
+/**
+ * _nb_resume - writes what is buffered and formats the saved batch on
+ * from where it stalled, call it when poll reports the descriptor writable
+ * @nb: stream
+ *
+ * Return: 0 once all is written, 1 if it would block again, -1 on error
+ */
+
+int _nb_resume(nbstream_t *nb)
+{
+	buffer_t *output;
+
+	if (nb == NULL || nb->output->error)
+		return (-1);
+	output = nb->output;
+	_nb_skip(nb, 0);
+	if (_nb_write(output) < 0)
+		return (-1);
+	if (nb->ops == NULL || output->len == output->size)
+		return (output->len > 0);
+	return (_nb_run(nb));
+}
+
+/**
+ * _nb_close - writes what goes out without blocking and frees the stream
+ * @nb: stream
+ *
+ * Return: 0, -1 if anything was left unwritten or on error
+ */
+
+int _nb_close(nbstream_t *nb)
+{
+	int ret = -1;
+
+	if (nb == NULL)
+		return (-1);
+	_nb_skip(nb, 0);
+	if (nb->ops == NULL && !nb->output->error)
+		ret = _nb_write(nb->output);
+	free_buffer(nb->output);
+	_pool_put(nb, sizeof(nbstream_t));
+	return ((ret == 0) ? 0 : -1);
+}
+
+/**
+ * _nb_run - stores the saved batch piece by piece, a piece being the text
+ * before a directive or its field; a piece that stalls is stored again on
+ * the next run with the bytes already stored skipped
+ * @nb: stream
+ *
+ * Return: 0 once all is written, 1 if it would block, -1 on error
+ */
+
+int _nb_run(nbstream_t *nb)
+{
+	const fmt_op_t *op;
+	const char *record;
+	unsigned long int mark;
+
+	for (; nb->row < nb->count; nb->row++)
+	{
+		record = nb->records + nb->row * nb->stride;
+		for (; ; nb->piece++)
+		{
+			op = nb->ops + nb->piece / 2;
+			if (nb->piece % 2 == 1 && op->spec == 0)
+				break;
+			mark = nb->sent + nb->output->len;
+			_nb_skip(nb, nb->skip);
+			if (nb->piece % 2 == 0)
+				_memcpy(nb->output, op->text, op->n);
+			else if (op->spec == '%')
+				_batch_field(nb->output, op, NULL);
+			else
+				_batch_field(nb->output, op, record +
+						nb->describe[nb->field]);
+			if (_nb_settle(nb, mark))
+				return (nb->output->error ? -1 : 1);
+			nb->field += (nb->piece % 2 == 1 && op->spec != '%');
+		}
+		nb->piece = 0;
+		nb->field = 0;
+	}
+	nb->ops = NULL;
+	return (_nb_write(nb->output));
+}
@@ -0,0 +1,263 @@
+#include "main.h"
+#include <sys/uio.h>
+#include <errno.h>
+
+#define PAR_WORKERS 64
+#define PAR_CHUNK 4096
+
+/**
+ * struct crew_s - job and round state shared by the workers
+ * @ops: compiled format
+ * @records: array of records
+ * @count: no of records
+ * @stride: bytes from one record to the next
+ * @describe: field offset of each directive
+ * @chunk: rows per chunk
+ * @rounds: no of rounds
+ * @workers: no of workers
+ * @round: rounds started so far
+ * @pending: threads still rendering the current round
+ * @lock: guards round and pending
+ * @cond: signalled when either changes
+ */
+typedef struct crew_s
+{
+	const fmt_op_t *ops;
+	const char *records;
+	unsigned long int count;
+	unsigned long int stride;
+	const unsigned long int *describe;
+	unsigned long int chunk;
+	unsigned long int rounds;
+	unsigned int workers;
+	unsigned long int round;
+	unsigned int pending;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+} crew_t;
+
+/**
+ * struct worker_s - one slot of a parallel batch
+ * @crew: shared state
+ * @id: index of the worker, its chunk in each round
+ * @ctx: string context the chunk is rendered into, reused every round
+ * @ret: no of bytes rendered, -1 on error
+ */
+typedef struct worker_s
+{
+	crew_t *crew;
+	unsigned int id;
+	printf_ctx_t *ctx;
+	long int ret;
+} worker_t;
+
+long int _printf_parallel(int fd, const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe, unsigned int workers);
+void _par_chunk(worker_t *w, unsigned long int r);
+void *_par_render(void *arg);
+long int _par_run(int fd, crew_t *crew, worker_t *w, pthread_t *threads);
+int _par_write(int fd, worker_t *w, unsigned int workers);
+
+/**
+ * _printf_parallel - prints records with one format, rendering chunks of
+ * rows on a pool of threads; each round the chunks are written in row
+ * order with one writev, so the output is the one of _printf_batch
+ * @fd: file descriptor to write to
+ * @format: format, see _printf_compile
+ * @records: array of records
+ * @count: no of records
+ * @stride: bytes from one record to the next
+ * @describe: field offset of each directive but %%
+ * @workers: no of threads, one per online cpu if 0, at most 64
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+long int _printf_parallel(int fd, const char *format, const void *records,
+		unsigned long int count, unsigned long int stride,
+		const unsigned long int *describe, unsigned int workers)
+{
+	worker_t w[PAR_WORKERS];
+	pthread_t threads[PAR_WORKERS];
+	crew_t crew;
+	long int ret;
+
+	if (workers == 0)
+		workers = sysconf(_SC_NPROCESSORS_ONLN);
+	crew.workers = (workers < 1) ? 1 : (workers > PAR_WORKERS) ?
+		PAR_WORKERS : workers;
+	crew.ops = _printf_compile(format);
+	if (crew.ops == NULL || (count > 0 && (!records || !describe)))
+	{
+		free((void *)crew.ops);
+		return (-1);
+	}
+	crew.records = records;
+	crew.count = count;
+	crew.stride = stride;
+	crew.describe = describe;
+	crew.chunk = (count + crew.workers - 1) / crew.workers;
+	if (crew.chunk > PAR_CHUNK || crew.chunk == 0)
+		crew.chunk = (crew.chunk == 0) ? 1 : PAR_CHUNK;
+	crew.rounds = (count + crew.chunk * crew.workers - 1) /
+		(crew.chunk * crew.workers);
+	crew.round = 0;
+	crew.pending = 0;
+	pthread_mutex_init(&crew.lock, NULL);
+	pthread_cond_init(&crew.cond, NULL);
+	ret = _par_run(fd, &crew, w, threads);
+	pthread_cond_destroy(&crew.cond);
+	pthread_mutex_destroy(&crew.lock);
+	free((void *)crew.ops);
+	return (ret);
+}
+
+/**
+ * _par_chunk - renders a worker's chunk of a round into its context
+ * @w: worker
+ * @r: round
+ */
+
+void _par_chunk(worker_t *w, unsigned long int r)
+{
+	crew_t *c = w->crew;
+	buffer_t *output = w->ctx->output;
+	unsigned long int first, n;
+	long int ret;
+
+	output->buffer = output->start;
+	output->len = 0;
+	first = (r * c->workers + w->id) * c->chunk;
+	n = (first < c->count) ? c->count - first : 0;
+	n = (n > c->chunk) ? c->chunk : n;
+	if (n == 0)
+		return;
+	ret = _ctx_batch(w->ctx, c->ops, c->records + first * c->stride, n,
+			c->stride, c->describe);
+	if (ret < 0 || output->error)
+		w->ret = -1;
+	else if (w->ret >= 0)
+		w->ret += ret;
+}
+
+/**
+ * _par_render - worker thread, renders its chunk each time a round starts
+ * @arg: worker
+ *
+ * Return: NULL
+ */
+
+void *_par_render(void *arg)
+{
+	worker_t *w = arg;
+	crew_t *c = w->crew;
+	unsigned long int r;
+
+	for (r = 0; r < c->rounds; r++)
+	{
+		pthread_mutex_lock(&c->lock);
+		while (c->round <= r)
+			pthread_cond_wait(&c->cond, &c->lock);
+		pthread_mutex_unlock(&c->lock);
+		_par_chunk(w, r);
+		pthread_mutex_lock(&c->lock);
+		if (--c->pending == 0)
+			pthread_cond_broadcast(&c->cond);
+		pthread_mutex_unlock(&c->lock);
+	}
+	return (NULL);
+}
+
+/**
+ * _par_run - starts the threads and drives the rounds, rendering the
+ * chunks of workers whose thread could not start itself
+ * @fd: file descriptor
+ * @crew: shared state
+ * @w: workers
+ * @threads: thread ids
+ *
+ * Return: no. of characters, -1 on error
+ */
+
+long int _par_run(int fd, crew_t *crew, worker_t *w, pthread_t *threads)
+{
+	unsigned int i, started = 0;
+	unsigned long int r;
+	long int ret = 0;
+
+	for (i = 0; i < crew->workers; i++)
+	{
+		w[i].crew = crew;
+		w[i].id = i;
+		w[i].ret = 0;
+		w[i].ctx = _ctx_sink(_sink_string(0));
+		ret = (w[i].ctx == NULL) ? -1 : ret;
+	}
+	for (; ret == 0 && started < crew->workers; started++)
+		if (pthread_create(&threads[started], NULL, _par_render,
+					&w[started]) != 0)
+			break;
+	for (r = 0; r < crew->rounds; r++)
+	{
+		pthread_mutex_lock(&crew->lock);
+		crew->round = r + 1;
+		crew->pending = started;
+		pthread_cond_broadcast(&crew->cond);
+		pthread_mutex_unlock(&crew->lock);
+		for (i = started; ret == 0 && i < crew->workers; i++)
+			_par_chunk(&w[i], r);
+		pthread_mutex_lock(&crew->lock);
+		while (crew->pending > 0)
+			pthread_cond_wait(&crew->cond, &crew->lock);
+		pthread_mutex_unlock(&crew->lock);
+		if (ret == 0 && _par_write(fd, w, crew->workers) < 0)
+			ret = -1;
+	}
+	for (i = 0; i < crew->workers; i++)
+	{
+		if (i < started)
+			pthread_join(threads[i], NULL);
+		ret = (ret < 0 || w[i].ret < 0) ? -1 : ret + w[i].ret;
+		_ctx_close(w[i].ctx);
+	}
+	return (ret);
+}
+
+/**
+ * _par_write - writes the chunks of a round in order
+ * @fd: file descriptor
+ * @w: workers
+ * @workers: no of workers
+ *
+ * Return: 0, -1 on a write error
+ */
+
+int _par_write(int fd, worker_t *w, unsigned int workers)
+{
+	struct iovec iov[PAR_WORKERS];
+	unsigned int i, k = 0;
+	ssize_t n;
+
+	for (i = 0; i < workers; i++)
+	{
+		iov[i].iov_base = w[i].ctx->output->start;
+		iov[i].iov_len = w[i].ctx->output->len;
+	}
+	while (k < workers)
+	{
+		n = writev(fd, iov + k, workers - k);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+			return (-1);
+		for (; k < workers && (size_t)n >= iov[k].iov_len; k++)
+			n -= iov[k].iov_len;
+		if (k < workers)
+		{
+			iov[k].iov_base = (char *)iov[k].iov_base + n;
+			iov[k].iov_len -= n;
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,167 @@
+#include "main.h"
+
+unsigned int (*_plain(const char *spec, unsigned char len,
+		unsigned int (*f)(va_list, buffer_t *, unsigned char, int,
+			int, unsigned char)))(va_list, buffer_t *,
+		unsigned char, int, int, unsigned char);
+unsigned int _plain_int(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_dec(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_hex(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _plain_HEX(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+
+/**
+ * _plain - picks the straight-line converter for a directive with no
+ * flag, width or precision
+ * @spec: pointer to conv spec
+ * @len: length
+ * @f: converter from _specifiers
+ *
+ * Return: plain converter for %d %i %u %x %X %s, f otherwise
+ */
+
+unsigned int (*_plain(const char *spec, unsigned char len,
+		unsigned int (*f)(va_list, buffer_t *, unsigned char, int,
+			int, unsigned char)))(va_list, buffer_t *,
+		unsigned char, int, int, unsigned char)
+{
+	if (*spec == 'd' || *spec == 'i')
+		return (_plain_int);
+	if (*spec == 'u')
+		return (_plain_dec);
+	if (*spec == 'x')
+		return (_plain_hex);
+	if (*spec == 'X')
+		return (_plain_HEX);
+	if (*spec == 's' && len != LONG)
+		return (_plain_string);
+	return (f);
+}
+
+/**
+ * _plain_int - %d and %i with no flag, width or precision
+ * @ap: arg
+ * @output: struct
+ * @flag: unused
+ * @width: unused
+ * @precision: unused
+ * @len: length
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _plain_int(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	long int d;
+
+	(void)flag;
+	(void)width;
+	(void)precision;
+	if (len == LONG)
+		d = va_arg(ap, long int);
+	else
+		d = va_arg(ap, int);
+	if (len == SHORT)
+		d = (short)d;
+	else if (len == CHAR)
+		d = (signed char)d;
+	return (_kdec(output, (d < 0) ? 0UL - d : (unsigned long int)d,
+				d < 0));
+}
+
+/**
+ * _plain_dec - %u with no flag, width or precision
+ * @ap: arg
+ * @output: struct
+ * @flag: unused
+ * @width: unused
+ * @precision: unused
+ * @len: length
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _plain_dec(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	unsigned long int num;
+
+	(void)flag;
+	(void)width;
+	(void)precision;
+	if (len == LONG)
+		num = va_arg(ap, unsigned long int);
+	else
+		num = va_arg(ap, unsigned int);
+	if (len == SHORT)
+		num = (unsigned short)num;
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_kdec(output, num, 0));
+}
+
+/**
+ * _plain_hex - %x with no flag, width or precision
+ * @ap: arg
+ * @output: struct
+ * @flag: unused
+ * @width: unused
+ * @precision: unused
+ * @len: length
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _plain_hex(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	unsigned long int num;
+
+	(void)flag;
+	(void)width;
+	(void)precision;
+	if (len == LONG)
+		num = va_arg(ap, unsigned long int);
+	else
+		num = va_arg(ap, unsigned int);
+	if (len == SHORT)
+		num = (unsigned short)num;
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_khex(output, num, "0123456789abcdef"));
+}
+
+/**
+ * _plain_HEX - %X with no flag, width or precision
+ * @ap: arg
+ * @output: struct
+ * @flag: unused
+ * @width: unused
+ * @precision: unused
+ * @len: length
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _plain_HEX(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	unsigned long int num;
+
+	(void)flag;
+	(void)width;
+	(void)precision;
+	if (len == LONG)
+		num = va_arg(ap, unsigned long int);
+	else
+		num = va_arg(ap, unsigned int);
+	if (len == SHORT)
+		num = (unsigned short)num;
+	else if (len == CHAR)
+		num = (unsigned char)num;
+	return (_khex(output, num, "0123456789ABCDEF"));
+}
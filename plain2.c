@@ -0,0 +1,74 @@
+#include "main.h"
+
+unsigned int _plain_string(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _kdec(buffer_t *output, unsigned long int num, int neg);
+unsigned int _khex(buffer_t *output, unsigned long int num,
+		const char *digits);
+
+/**
+ * _plain_string - %s with no flag, width or precision
+ * @ap: arg
+ * @output: struct
+ * @flag: unused
+ * @width: unused
+ * @precision: unused
+ * @len: unused, %ls never comes here
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _plain_string(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	char *str = va_arg(ap, char *);
+
+	(void)flag;
+	(void)width;
+	(void)precision;
+	(void)len;
+	if (str == NULL)
+		return (_memcpy(output, "(null)", 6));
+	return (_strput(output, str, UINT_MAX));
+}
+
+/**
+ * _kdec - stores a decimal and its minus sign in one copy
+ * @output: struct
+ * @num: magnitude
+ * @neg: 1 to prefix a minus sign
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _kdec(buffer_t *output, unsigned long int num, int neg)
+{
+	char tmp[21];
+	unsigned int n;
+
+	n = _utoa(tmp + 1, num);
+	tmp[20 - n] = '-';
+	return (_memcpy(output, tmp + 21 - n - neg, n + neg));
+}
+
+/**
+ * _khex - stores a hex value in one copy
+ * @output: struct
+ * @num: value
+ * @digits: the 16 digits, lower or upper case
+ *
+ * Return: bytes stored
+ */
+
+unsigned int _khex(buffer_t *output, unsigned long int num,
+		const char *digits)
+{
+	char tmp[16];
+	unsigned int i = 16;
+
+	do {
+		tmp[--i] = digits[num & 15];
+		num >>= 4;
+	} while (num);
+	return (_memcpy(output, tmp + i, 16 - i));
+}
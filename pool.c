@@ -0,0 +1,149 @@
+#include "main.h"
+
+#define POOL_CLASSES 8
+#define POOL_SMALL 128
+#define POOL_KEEP 16
+#define POOL_LARGE (BUFF_SIZE * 64)
+#define POOL_CAP (BUFF_SIZE * 256)
+/* free list a block of n bytes comes from and goes back to */
+#define POOL_CLASS(n) ((n) <= POOL_SMALL ? 0U : (n) <= BUFF_SIZE ? 1U : \
+	1U + __builtin_clzl(BUFF_SIZE - 1) - __builtin_clzl((n) - 1))
+#define POOL_BLOCK(c) ((c) == 0 ? POOL_SMALL : (unsigned long int)BUFF_SIZE \
+	<< ((c) - 1))
+
+void _printf_allocator(void *(*alloc)(size_t), void (*release)(void *));
+void *_pool_get(unsigned long int size);
+void _pool_put(void *ptr, unsigned long int size);
+void _pool_drain(void *unused);
+long int _printf_pool_cap(long int bytes);
+
+static void *(*mem_alloc)(size_t) = malloc;
+static void (*mem_release)(void *) = free;
+static long int cap = POOL_CAP;
+
+static __thread void *cache[POOL_CLASSES];
+static __thread unsigned int cached[POOL_CLASSES];
+static __thread printf_stats_t *self;
+
+/**
+ * _printf_allocator - sets the allocator behind the pool, call it before
+ * any formatting; strings kept from _sink_string come from it too
+ * @alloc: malloc compatible, malloc if NULL
+ * @release: free compatible, free if NULL
+ */
+
+void _printf_allocator(void *(*alloc)(size_t), void (*release)(void *))
+{
+	_pool_drain(NULL);
+	mem_alloc = (alloc == NULL) ? malloc : alloc;
+	mem_release = (release == NULL) ? free : release;
+}
+
+/**
+ * _pool_get - takes a block from this thread's free list for the size
+ * class, blocks are 128 bytes or 1 KiB to 64 KiB in powers of two
+ * @size: no of bytes
+ *
+ * Return: pointer to at least size bytes, NULL when out of memory
+ */
+
+void *_pool_get(unsigned long int size)
+{
+	unsigned int c = POOL_CLASS(size);
+	unsigned long int block = POOL_BLOCK(c);
+	void *ptr;
+
+	if (self == NULL)
+		self = _stats_self();
+	if (c >= POOL_CLASSES || cache[c] == NULL)
+	{
+		ptr = mem_alloc((c >= POOL_CLASSES) ? size : block);
+		if (ptr != NULL)
+			STAT_ADD(self->live, size);
+		return (ptr);
+	}
+	ptr = cache[c];
+	cache[c] = *(void **)ptr;
+	cached[c]--;
+	STAT_ADD(self->cached, -(long int)block);
+	STAT_ADD(self->live, size);
+	return (ptr);
+}
+
+/**
+ * _pool_put - returns a block to the free list of the class _pool_get
+ * took it from, or to the allocator once the list is full
+ * @ptr: block from _pool_get, may be NULL
+ * @size: no of bytes the block was asked for with
+ */
+
+void _pool_put(void *ptr, unsigned long int size)
+{
+	unsigned int c = POOL_CLASS(size);
+	unsigned long int block = POOL_BLOCK(c);
+	unsigned int keep = (c == 0) ? POOL_KEEP * 4 : POOL_KEEP;
+
+	if (ptr == NULL)
+		return;
+	if (self == NULL)
+		self = _stats_self();
+	STAT_ADD(self->live, -(long int)size);
+	if (c >= POOL_CLASSES || cached[c] >= keep || self->cached + (long int)
+			block > __atomic_load_n(&cap, __ATOMIC_RELAXED))
+	{
+		mem_release(ptr);
+		return;
+	}
+	*(void **)ptr = cache[c];
+	cache[c] = ptr;
+	cached[c]++;
+	STAT_ADD(self->cached, block);
+}
+
+/**
+ * _pool_drain - gives every block on this thread's free lists back to
+ * the allocator, _stats_exit runs it when a thread exits
+ * @unused: key value
+ */
+
+void _pool_drain(void *unused)
+{
+	unsigned int c;
+	void *ptr;
+
+	(void)unused;
+	for (c = 0; c < POOL_CLASSES; c++)
+	{
+		while (cache[c] != NULL)
+		{
+			ptr = cache[c];
+			cache[c] = *(void **)ptr;
+			mem_release(ptr);
+		}
+		cached[c] = 0;
+	}
+	if (self != NULL)
+		STAT_ADD(self->cached, -self->cached);
+	self = NULL;
+}
+
+/**
+ * _printf_pool_cap - bounds the bytes each thread keeps on its free
+ * lists, blocks that would go over are given back to the allocator; the
+ * calling thread empties its lists if they already hold more
+ * @bytes: the bound, 0 keeps nothing, -1 to only query
+ *
+ * Return: the previous bound
+ */
+
+long int _printf_pool_cap(long int bytes)
+{
+	long int prev = __atomic_load_n(&cap, __ATOMIC_RELAXED);
+
+	if (bytes < 0)
+		return (prev);
+	__atomic_store_n(&cap, bytes, __ATOMIC_RELAXED);
+	if (self != NULL && self->cached > bytes)
+		_pool_drain(NULL);
+	return (prev);
+}
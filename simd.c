@@ -0,0 +1,241 @@
+#include "main.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+unsigned int _print_span(const char *str, unsigned int n);
+void _rot13(char *dst, const char *src, unsigned int n);
+void _reverse(char *dst, const char *src, unsigned int n);
+unsigned int _strput(buffer_t *output, const char *str, unsigned int max);
+unsigned int _quote_span(const char *str, unsigned int n, unsigned char below,
+		const char *stop);
+
+/**
+ * _print_span - counts leading printable bytes (0x20 - 0x7e)
+ * @str: pointer
+ * @n: no of bytes to look at
+ *
+ * Return: length of the clean run
+ */
+unsigned int _print_span(const char *str, unsigned int n)
+{
+	unsigned int i = 0, bad;
+	unsigned char c;
+
+#if defined(__AVX2__)
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+		__m256i ok = _mm256_and_si256(
+				_mm256_cmpgt_epi8(v, _mm256_set1_epi8(31)),
+				_mm256_cmpgt_epi8(_mm256_set1_epi8(127), v));
+
+		bad = ~(unsigned int)_mm256_movemask_epi8(ok);
+		if (bad)
+			return (i + __builtin_ctz(bad));
+	}
+#endif
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+		__m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(31)),
+				_mm_cmplt_epi8(v, _mm_set1_epi8(127)));
+
+		bad = ~(unsigned int)_mm_movemask_epi8(ok) & 0xffff;
+		if (bad)
+			return (i + __builtin_ctz(bad));
+	}
+#endif
+	for (; i < n; i++)
+	{
+		c = str[i];
+		if (c < 32 || c >= 127)
+			break;
+	}
+	(void)bad;
+	return (i);
+}
+
+/**
+ * _rot13 - branch free rot13 of n bytes
+ * @dst: destination, may be in the output buffer
+ * @src: source string
+ * @n: no of bytes
+ */
+void _rot13(char *dst, const char *src, unsigned int n)
+{
+	unsigned int i = 0;
+	unsigned char l, alpha, late;
+
+#if defined(__AVX2__)
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+		__m256i lo = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+		__m256i end = _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lo);
+		__m256i a = _mm256_cmpgt_epi8(lo, _mm256_set1_epi8('a' - 1));
+		__m256i b = _mm256_cmpgt_epi8(lo, _mm256_set1_epi8('n' - 1));
+
+		v = _mm256_add_epi8(v, _mm256_and_si256(end, _mm256_sub_epi8(
+				_mm256_and_si256(a, _mm256_set1_epi8(13)),
+				_mm256_and_si256(b, _mm256_set1_epi8(26)))));
+		_mm256_storeu_si256((__m256i *)(dst + i), v);
+	}
+#endif
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i lo = _mm_or_si128(v, _mm_set1_epi8(0x20));
+		__m128i end = _mm_cmplt_epi8(lo, _mm_set1_epi8('z' + 1));
+		__m128i a = _mm_cmpgt_epi8(lo, _mm_set1_epi8('a' - 1));
+		__m128i b = _mm_cmpgt_epi8(lo, _mm_set1_epi8('n' - 1));
+
+		v = _mm_add_epi8(v, _mm_and_si128(end, _mm_sub_epi8(
+					_mm_and_si128(a, _mm_set1_epi8(13)),
+					_mm_and_si128(b, _mm_set1_epi8(26)))));
+		_mm_storeu_si128((__m128i *)(dst + i), v);
+	}
+#endif
+	for (; i < n; i++)
+	{
+		l = (unsigned char)((src[i] | 0x20) - 'a');
+		alpha = -(unsigned char)(l < 26);
+		late = -(unsigned char)((unsigned char)(l - 13) < 13);
+		dst[i] = src[i] + ((alpha & 13) - (late & 26));
+	}
+}
+
+/**
+ * _reverse - writes n bytes of src to dst in reverse order
+ * @dst: destination, must not overlap src
+ * @src: source bytes
+ * @n: no of bytes
+ */
+void _reverse(char *dst, const char *src, unsigned int n)
+{
+	unsigned int i = 0;
+#if defined(__SSSE3__)
+	__m128i rev = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+			8, 9, 10, 11, 12, 13, 14, 15);
+#endif
+
+#if defined(__AVX2__)
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256(
+				(const __m256i *)(src + n - i - 32));
+
+		v = _mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(rev));
+		v = _mm256_permute2x128_si256(v, v, 1);
+		_mm256_storeu_si256((__m256i *)(dst + i), v);
+	}
+#endif
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128(
+				(const __m128i *)(src + n - i - 16));
+
+#if defined(__SSSE3__)
+		v = _mm_shuffle_epi8(v, rev);
+#else
+		v = _mm_or_si128(_mm_srli_epi16(v, 8), _mm_slli_epi16(v, 8));
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1b), 0x1b);
+		v = _mm_shuffle_epi32(v, 0x4e);
+#endif
+		_mm_storeu_si128((__m128i *)(dst + i), v);
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = src[n - i - 1];
+}
+
+/**
+ * _strput - copies at most max bytes of a string, scanning and copying
+ * one buffer window at a time so no byte past the cap is read
+ * @output: struct
+ * @str: string
+ * @max: cap on the no of bytes, ie the precision
+ *
+ * Return: no of bytes stored
+ */
+unsigned int _strput(buffer_t *output, const char *str, unsigned int max)
+{
+	unsigned int i, n, k;
+	char *dst;
+
+	for (i = 0; i < max; i += k)
+	{
+		n = max - i;
+		dst = _reserve(output, &n);
+		k = strnlen(str + i, n);
+		memcpy(dst, str + i, k);
+		_commit(output, k);
+		if (k < n)
+			return (i + k);
+	}
+	return (i);
+}
+
+/**
+ * _quote_span - counts leading bytes that need no quoting or escaping
+ * @str: pointer
+ * @n: no of bytes to look at
+ * @below: bytes under this value must be escaped
+ * @stop: 3 more bytes that must be escaped
+ *
+ * Return: length of the clean run
+ */
+unsigned int _quote_span(const char *str, unsigned int n, unsigned char below,
+		const char *stop)
+{
+	unsigned int i = 0, bad;
+
+#if defined(__AVX2__)
+	__m256i lo = _mm256_set1_epi8(below), w, v;
+	__m256i s0 = _mm256_set1_epi8(stop[0]), s1 = _mm256_set1_epi8(stop[1]);
+	__m256i s2 = _mm256_set1_epi8(stop[2]);
+
+	for (; i + 32 <= n; i += 32)
+	{
+		v = _mm256_loadu_si256((const __m256i *)(str + i));
+		w = _mm256_cmpeq_epi8(_mm256_max_epu8(v, lo), v);
+		w = _mm256_andnot_si256(_mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, s0),
+				_mm256_cmpeq_epi8(v, s1)),
+				_mm256_cmpeq_epi8(v, s2)), w);
+		bad = ~(unsigned int)_mm256_movemask_epi8(w);
+		if (bad)
+			return (i + __builtin_ctz(bad));
+	}
+#endif
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+		__m128i w = _mm_max_epu8(v, _mm_set1_epi8(below));
+		__m128i e = _mm_cmpeq_epi8(v, _mm_set1_epi8(stop[0]));
+
+		e = _mm_or_si128(e, _mm_cmpeq_epi8(v, _mm_set1_epi8(stop[1])));
+		e = _mm_or_si128(e, _mm_cmpeq_epi8(v, _mm_set1_epi8(stop[2])));
+		w = _mm_andnot_si128(e, _mm_cmpeq_epi8(w, v));
+		bad = ~(unsigned int)_mm_movemask_epi8(w) & 0xffff;
+		if (bad)
+			return (i + __builtin_ctz(bad));
+	}
+#endif
+	for (; i < n && (unsigned char)str[i] >= below; i++)
+		if (str[i] == stop[0] || str[i] == stop[1] || str[i] == stop[2])
+			break;
+	(void)bad;
+	return (i);
+}
@@ -0,0 +1,95 @@
+#include "main.h"
+
+/**
+ * struct callback_s - state of a callback sink
+ * @fn: receives each chunk of output
+ * @arg: passed back to fn
+ */
+typedef struct callback_s
+{
+	int (*fn)(void *arg, const char *buf, unsigned int n);
+	void *arg;
+} callback_t;
+
+buffer_t *_sink_callback(int (*fn)(void *, const char *, unsigned int),
+		void *arg, unsigned int size);
+int _cb_flush(buffer_t *output);
+int _cb_close(buffer_t *output);
+
+static const sink_t callback_sink = {_cb_flush, _cb_flush, _cb_flush,
+	_cb_close, 0};
+
+/**
+ * _sink_callback - buffer handing its output to a user function, once
+ * per formatted call or whenever the buffer fills
+ * @fn: returns < 0 on error
+ * @arg: passed back to fn
+ * @size: capacity, BUFF_SIZE if 0
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_callback(int (*fn)(void *, const char *, unsigned int),
+		void *arg, unsigned int size)
+{
+	buffer_t *output;
+	callback_t *cb;
+	char *start;
+
+	size = (size == 0) ? BUFF_SIZE : size;
+	cb = _pool_get(sizeof(callback_t));
+	start = _pool_get(size);
+	output = (cb && start) ? _buffer(start, size, &callback_sink, cb) :
+		NULL;
+	if (output == NULL)
+	{
+		_pool_put(cb, sizeof(callback_t));
+		_pool_put(start, size);
+		return (NULL);
+	}
+	cb->fn = fn;
+	cb->arg = arg;
+	return (output);
+}
+
+/**
+ * _cb_flush - passes the buffered bytes to the callback
+ * @output: struct
+ *
+ * Return: no of bytes passed, -1 if the callback failed
+ */
+
+int _cb_flush(buffer_t *output)
+{
+	callback_t *cb = output->data;
+	int n = output->len;
+
+	if (n > 0)
+	{
+		output->flushes++;
+		if (cb->fn(cb->arg, output->start, output->len) < 0)
+		{
+			output->error = 1;
+			n = -1;
+		}
+	}
+	output->buffer = output->start;
+	output->len = 0;
+	return (n);
+}
+
+/**
+ * _cb_close - final flush, frees the callback state
+ * @output: struct
+ *
+ * Return: 0, -1 if the callback failed
+ */
+
+int _cb_close(buffer_t *output)
+{
+	int ret = _cb_flush(output);
+
+	_pool_put(output->data, sizeof(callback_t));
+	output->data = NULL;
+	return ((ret < 0) ? -1 : 0);
+}
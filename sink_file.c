@@ -0,0 +1,136 @@
+#define _GNU_SOURCE
+#include "main.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/**
+ * struct mapfile_s - state of a memory-mapped file sink
+ * @map: mapping of the file
+ * @mapped: bytes mapped, the file is this long until _close
+ * @scratch: where bytes are dropped once the file cannot grow
+ */
+typedef struct mapfile_s
+{
+	char *map;
+	unsigned int mapped;
+	char scratch[64];
+} mapfile_t;
+
+buffer_t *_sink_mmap(const char *path, unsigned int size);
+int _map_grow(buffer_t *output);
+int _map_sync(buffer_t *output);
+int _map_close(buffer_t *output);
+
+static const sink_t mmap_sink = {_map_grow, NULL, _map_sync, _map_close,
+	1};
+
+/**
+ * _sink_mmap - buffer formatting straight into a memory-mapped file, so
+ * a full buffer costs a remap instead of a write
+ * @path: file, created or truncated
+ * @size: initial mapping size, BUFF_SIZE * 64 if 0
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_mmap(const char *path, unsigned int size)
+{
+	buffer_t *output = NULL;
+	mapfile_t *file;
+	int fd;
+
+	size = (size == 0) ? BUFF_SIZE * 64 : size;
+	file = _pool_get(sizeof(mapfile_t));
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file != NULL && fd >= 0 && ftruncate(fd, size) == 0)
+	{
+		file->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+				fd, 0);
+		file->mapped = size;
+		if (file->map != MAP_FAILED)
+			output = _buffer(file->map, size, &mmap_sink, file);
+		if (output == NULL && file->map != MAP_FAILED)
+			munmap(file->map, size);
+	}
+	if (output == NULL)
+	{
+		_pool_put(file, sizeof(mapfile_t));
+		if (fd >= 0)
+			close(fd);
+		return (NULL);
+	}
+	output->fd = fd;
+	return (output);
+}
+
+/**
+ * _map_grow - doubles the file and its mapping
+ * @output: struct
+ *
+ * Return: 0, -1 once the file cannot grow and bytes are dropped
+ */
+
+int _map_grow(buffer_t *output)
+{
+	mapfile_t *file = output->data;
+	char *map = MAP_FAILED;
+
+	if (output->start == file->map && file->mapped <= UINT_MAX / 2 &&
+			ftruncate(output->fd, file->mapped * 2) == 0)
+		map = mremap(file->map, file->mapped, file->mapped * 2,
+				MREMAP_MAYMOVE);
+	if (map != MAP_FAILED)
+	{
+		file->map = output->start = map;
+		output->buffer = map + output->len;
+		file->mapped *= 2;
+		output->size = file->mapped;
+		return (0);
+	}
+	output->error = 1;
+	output->start = file->scratch;
+	output->size = sizeof(file->scratch);
+	output->buffer = output->start;
+	output->len = 0;
+	return (-1);
+}
+
+/**
+ * _map_sync - starts writeback of the mapped bytes
+ * @output: struct
+ *
+ * Return: 0, -1 on error
+ */
+
+int _map_sync(buffer_t *output)
+{
+	mapfile_t *file = output->data;
+
+	output->flushes++;
+	return (msync(file->map, file->mapped, MS_ASYNC));
+}
+
+/**
+ * _map_close - cuts the file to the bytes written and unmaps it
+ * @output: struct
+ *
+ * Return: 0, -1 on error
+ */
+
+int _map_close(buffer_t *output)
+{
+	mapfile_t *file = output->data;
+	unsigned int len = file->mapped;
+	int ret = 0;
+
+	if (output->start == file->map)
+		len = output->len;
+	munmap(file->map, file->mapped);
+	if (ftruncate(output->fd, len) < 0)
+		ret = -1;
+	close(output->fd);
+	_pool_put(file, sizeof(mapfile_t));
+	output->data = NULL;
+	output->start = NULL;
+	return (ret);
+}
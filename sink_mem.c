@@ -0,0 +1,150 @@
+#include "main.h"
+
+/**
+ * struct spill_s - state of a caller memory sink
+ * @mem: caller memory
+ * @scratch: where bytes past the end of mem are dropped
+ */
+typedef struct spill_s
+{
+	char *mem;
+	char scratch[64];
+} spill_t;
+
+buffer_t *_sink_string(unsigned int size);
+buffer_t *_sink_memory(char *mem, unsigned int size);
+int _grow(buffer_t *output);
+int _spill(buffer_t *output);
+int _terminate(buffer_t *output);
+
+static const sink_t string_sink = {_grow, NULL, NULL, _terminate, 1};
+static const sink_t memory_sink = {_spill, NULL, NULL, _terminate, 1};
+
+/**
+ * _sink_string - buffer that grows geometrically into a heap string
+ * @size: initial capacity, BUFF_SIZE if 0
+ *
+ * Return: pointer to buffer_t, after _close start holds the NUL
+ * terminated string, which the caller may keep by setting start to NULL
+ * and later release with free (or the _printf_allocator release)
+ */
+
+buffer_t *_sink_string(unsigned int size)
+{
+	buffer_t *output;
+	char *start;
+
+	if (size == 0)
+		size = BUFF_SIZE;
+	start = _pool_get(size);
+	if (start == NULL)
+		return (NULL);
+	output = _buffer(start, size, &string_sink, NULL);
+	if (output == NULL)
+		_pool_put(start, size);
+	return (output);
+}
+
+/**
+ * _sink_memory - buffer writing into caller memory like snprintf, bytes
+ * past size - 1 are counted by the caller but dropped
+ * @mem: caller memory, NUL terminated on _close
+ * @size: size of mem, at least 1
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_memory(char *mem, unsigned int size)
+{
+	buffer_t *output;
+	spill_t *spill;
+
+	if (mem == NULL || size == 0)
+		return (NULL);
+	spill = _pool_get(sizeof(spill_t));
+	if (spill == NULL)
+		return (NULL);
+	spill->mem = mem;
+	output = _buffer(mem, size - 1, &memory_sink, spill);
+	if (output == NULL)
+		_pool_put(spill, sizeof(spill_t));
+	return (output);
+}
+
+/**
+ * _grow - doubles the string, or starts dropping bytes if out of memory
+ * @output: struct
+ *
+ * Return: 0, -1 when out of memory
+ */
+
+int _grow(buffer_t *output)
+{
+	char *start;
+
+	if (output->error == 0 && output->size <= UINT_MAX / 2)
+	{
+		start = _pool_get(output->size * 2);
+		if (start != NULL)
+		{
+			memcpy(start, output->start, output->len);
+			_pool_put(output->start, output->size);
+			output->start = start;
+			output->buffer = start + output->len;
+			output->size *= 2;
+			return (0);
+		}
+	}
+	output->error = 1;
+	output->buffer = output->start;
+	output->len = 0;
+	return (-1);
+}
+
+/**
+ * _spill - caller memory is full, NUL terminate it and drop later bytes
+ * @output: struct
+ *
+ * Return: 0
+ */
+
+int _spill(buffer_t *output)
+{
+	spill_t *spill = output->data;
+
+	if (output->start == spill->mem)
+	{
+		*output->buffer = '\0';
+		output->start = spill->scratch;
+		output->size = sizeof(spill->scratch);
+	}
+	output->buffer = output->start;
+	output->len = 0;
+	return (0);
+}
+
+/**
+ * _terminate - NUL terminates a string or caller memory sink
+ * @output: struct
+ *
+ * Return: 0, -1 if the string ran out of memory
+ */
+
+int _terminate(buffer_t *output)
+{
+	spill_t *spill = output->data;
+
+	if (spill == NULL)
+	{
+		if (output->len == output->size)
+			_grow(output);
+		*output->buffer = '\0';
+		return (output->error ? -1 : 0);
+	}
+	if (output->start == spill->mem)
+		*output->buffer = '\0';
+	_pool_put(spill, sizeof(spill_t));
+	output->data = NULL;
+	output->start = NULL;
+	return (0);
+}
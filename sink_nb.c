@@ -0,0 +1,172 @@
+#include "main.h"
+#include <errno.h>
+
+nbstream_t *_nb_open(int fd, unsigned int size);
+int _nb_write(buffer_t *output);
+int _nb_reserve(buffer_t *output);
+void _nb_skip(nbstream_t *nb, unsigned long int skip);
+int _nb_settle(nbstream_t *nb, unsigned long int mark);
+
+static const sink_t nb_sink = {_nb_reserve, NULL, NULL, NULL, 0};
+
+/**
+ * _nb_open - resumable stream over a descriptor opened with O_NONBLOCK,
+ * formatting never waits on it; see _nb_batch. Only compiled batches can
+ * be resumed: a va_list can't outlive the call, so there is no varargs
+ * form. The unsent tail of a stalled piece is not kept either; the piece
+ * (one literal or one field) is formatted again on resume and the bytes
+ * already stored skipped, so the buffer stays at size however long the
+ * field is, at the cost of formatting a stalled field twice
+ * @fd: file descriptor
+ * @size: capacity, BUFF_SIZE if 0, at least NB_SPILL
+ *
+ * Return: stream, close it with _nb_close, NULL on failure
+ */
+
+nbstream_t *_nb_open(int fd, unsigned int size)
+{
+	nbstream_t *nb;
+	char *start;
+
+	size = (size == 0) ? BUFF_SIZE : (size < NB_SPILL) ? NB_SPILL : size;
+	nb = _pool_get(sizeof(nbstream_t));
+	start = _pool_get(size);
+	if (nb != NULL && start != NULL)
+	{
+		memset(nb, 0, sizeof(nbstream_t));
+		nb->output = _buffer(start, size, &nb_sink, nb);
+		if (nb->output != NULL)
+		{
+			nb->output->fd = fd;
+			return (nb);
+		}
+	}
+	_pool_put(start, size);
+	_pool_put(nb, sizeof(nbstream_t));
+	return (NULL);
+}
+
+/**
+ * _nb_write - writes what the descriptor takes without blocking and
+ * moves the rest to the front of the buffer
+ * @output: struct, storing to the real buffer
+ *
+ * Return: 0 once empty, 1 if bytes are left, -1 on a write error
+ */
+
+int _nb_write(buffer_t *output)
+{
+	nbstream_t *nb = output->data;
+	unsigned int done = 0;
+	ssize_t n = 0;
+
+	while (done < output->len)
+	{
+		n = write(output->fd, output->start + done, output->len - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		done += n;
+	}
+	if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		output->error = 1;
+	if (done > 0)
+	{
+		memmove(output->start, output->start + done,
+				output->len - done);
+		output->len -= done;
+		output->buffer = output->start + output->len;
+		output->flushes++;
+		nb->sent += done;
+	}
+	return (output->error ? -1 : output->len > 0);
+}
+
+/**
+ * _nb_reserve - makes room: writes out the buffer, or once the
+ * descriptor would block keeps it and drops the rest of the piece into
+ * spill; while skipping, hands out spill up to the bytes left to skip
+ * @output: struct
+ *
+ * Return: 0
+ */
+
+int _nb_reserve(buffer_t *output)
+{
+	nbstream_t *nb = output->data;
+
+	if (nb->mode == NB_SKIP)
+	{
+		nb->left -= nb->grant;
+		if (nb->left > 0)
+		{
+			nb->grant = (nb->left < NB_SPILL) ? nb->left : NB_SPILL;
+			output->buffer = nb->spill;
+			output->len = output->size - nb->grant;
+			return (0);
+		}
+		_nb_skip(nb, 0);
+		if (output->len < output->size)
+			return (0);
+	}
+	if (nb->mode == NB_REAL && !output->error)
+		_nb_write(output);
+	if (nb->mode == NB_REAL && output->len < output->size)
+		return (0);
+	if (nb->mode == NB_REAL)
+		nb->kept = output->len;
+	nb->mode = NB_DROP;
+	output->buffer = nb->spill;
+	output->len = output->size - NB_SPILL;
+	return (0);
+}
+
+/**
+ * _nb_skip - goes back to storing to the real buffer, then has the next
+ * skip bytes stored to spill, the part of a piece sent before a stall
+ * @nb: stream
+ * @skip: no of bytes
+ */
+
+void _nb_skip(nbstream_t *nb, unsigned long int skip)
+{
+	buffer_t *output = nb->output;
+
+	if (nb->mode != NB_REAL)
+	{
+		output->len = nb->kept;
+		output->buffer = output->start + nb->kept;
+		nb->mode = NB_REAL;
+	}
+	if (skip == 0)
+		return;
+	nb->kept = output->len;
+	nb->mode = NB_SKIP;
+	nb->left = skip;
+	nb->grant = (skip < NB_SPILL) ? skip : NB_SPILL;
+	output->buffer = nb->spill;
+	output->len = output->size - nb->grant;
+}
+
+/**
+ * _nb_settle - ends a piece; if it stalled, adds the bytes it stored to
+ * the skip of its next attempt
+ * @nb: stream
+ * @mark: sent plus buffered bytes when the piece started
+ *
+ * Return: 0 if the piece is stored, 1 if it stalled
+ */
+
+int _nb_settle(nbstream_t *nb, unsigned long int mark)
+{
+	if (nb->mode == NB_SKIP)
+		_nb_skip(nb, 0);
+	if (nb->mode == NB_REAL)
+	{
+		nb->skip = 0;
+		return (0);
+	}
+	nb->skip += nb->sent + nb->kept - mark;
+	return (1);
+}
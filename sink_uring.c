@@ -0,0 +1,178 @@
+#include "main.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+buffer_t *_sink_uring(int fd, unsigned int size, unsigned int depth);
+int _ring_wait(buffer_t *output, unsigned int slot);
+int _ring_submit(buffer_t *output);
+int _ring_close(buffer_t *output);
+
+static const sink_t uring_sink = {_ring_submit, NULL, _ring_submit,
+	_ring_close, 0};
+
+/**
+ * _sink_uring - buffer writing to a file descriptor through io_uring;
+ * a full buffer is queued and formatting goes on in the next one while
+ * the kernel writes it, falls back to init_buffer without io_uring or
+ * its write op; buffers for a seekable file are written at their own
+ * offsets and may overlap, the file position is moved past them on close,
+ * while a pipe, socket or O_APPEND file gets one write at a time
+ * @fd: blocking file descriptor to write to
+ * @size: capacity of each buffer, BUFF_SIZE * 16 if 0
+ * @depth: no of buffers, 2 (double buffering) to 8
+ *
+ * Return: pointer to buffer_t, NULL on failure
+ */
+
+buffer_t *_sink_uring(int fd, unsigned int size, unsigned int depth)
+{
+	buffer_t *output = NULL;
+	uring_t *u;
+
+	size = (size == 0) ? BUFF_SIZE * 16 : size;
+	depth = (depth < 2) ? 2 : (depth > RING_DEPTH) ? RING_DEPTH : depth;
+	u = _pool_get(sizeof(uring_t));
+	if (u != NULL)
+	{
+		memset(u, 0, sizeof(uring_t));
+		u->block = _pool_get((unsigned long int)size * depth);
+	}
+	if (u != NULL && u->block != NULL)
+		output = _buffer(u->block, size, &uring_sink, u);
+	if (output == NULL)
+	{
+		if (u != NULL)
+			_pool_put(u->block, (unsigned long int)size * depth);
+		_pool_put(u, sizeof(uring_t));
+		return (NULL);
+	}
+	if (_ring_setup(u, depth) < 0)
+	{
+		_pool_put(u->block, (unsigned long int)size * depth);
+		output->start = NULL;
+		free_buffer(output);
+		_pool_put(u, sizeof(uring_t));
+		return (init_buffer(fd, size));
+	}
+	u->depth = depth;
+	u->off = (fcntl(fd, F_GETFL) & O_APPEND) ? -1 : lseek(fd, 0, SEEK_CUR);
+	output->fd = fd;
+	return (output);
+}
+
+/**
+ * _ring_wait - reaps every completion ready, blocking only while the
+ * wanted buffer is still queued; short writes are finished with write
+ * @output: struct
+ * @slot: buffer to wait for, depth to wait for all of them
+ *
+ * Return: 0, -1 if a write failed
+ */
+
+int _ring_wait(buffer_t *output, unsigned int slot)
+{
+	uring_t *u = output->data;
+	struct io_uring_cqe *cqe;
+	unsigned int head, tail;
+
+	while ((slot < u->depth) ? u->pending[slot] != 0 : u->inflight != 0)
+	{
+		head = *u->cq_head;
+		tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+		if (head == tail && syscall(__NR_io_uring_enter, u->ring, 0, 1,
+					IORING_ENTER_GETEVENTS, NULL, 0) < 0 &&
+				errno != EINTR)
+		{
+			output->error = 1;
+			return (-1);
+		}
+		for (; head != tail; head++, u->inflight--)
+		{
+			cqe = &u->cqes[head & *u->cq_mask];
+			if (_ring_finish(output, cqe->user_data, cqe->res) < 0)
+				output->error = 1;
+			u->pending[cqe->user_data] = 0;
+		}
+		__atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+	}
+	return (output->error ? -1 : 0);
+}
+
+/**
+ * _ring_submit - queues the buffered bytes as a write at the next file
+ * offset, or drained after the writes before it when there is no offset,
+ * and moves on to the next buffer, waiting for it only if the kernel is
+ * still writing it; if the kernel refuses the submission it writes them
+ * itself and writes the rest at the file position
+ * @output: struct
+ *
+ * Return: no of bytes queued, -1 on error
+ */
+
+int _ring_submit(buffer_t *output)
+{
+	uring_t *u = output->data;
+	struct io_uring_sqe *sqe;
+	unsigned int tail, n = output->len;
+
+	if (n == 0)
+		return (0);
+	tail = *u->sq_tail;
+	sqe = &u->sqes[tail & *u->sq_mask];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_WRITE;
+	sqe->flags = (u->off < 0) ? IOSQE_IO_DRAIN : 0;
+	sqe->fd = output->fd;
+	sqe->off = (unsigned long int)u->off;
+	sqe->addr = (unsigned long int)output->start;
+	sqe->len = n;
+	sqe->user_data = u->slot;
+	u->sq_array[tail & *u->sq_mask] = tail & *u->sq_mask;
+	__atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	if (syscall(__NR_io_uring_enter, u->ring, 1, 0, 0, NULL, 0) < 0)
+	{
+		__atomic_store_n(u->sq_tail, tail, __ATOMIC_RELEASE);
+		_ring_wait(output, u->depth);
+		if (u->off >= 0)
+			lseek(output->fd, u->off, SEEK_SET);
+		u->off = -1;
+		return (_fd_flush(output));
+	}
+	u->pending[u->slot] = n;
+	u->at[u->slot] = u->off;
+	u->off += (u->off < 0) ? 0 : n;
+	u->inflight++;
+	output->flushes++;
+	u->slot = (u->slot + 1) % u->depth;
+	output->start = u->block + u->slot * output->size;
+	output->buffer = output->start;
+	output->len = 0;
+	return ((_ring_wait(output, u->slot) < 0) ? -1 : (int)n);
+}
+
+/**
+ * _ring_close - queues the rest, waits for every write and frees the ring
+ * @output: struct
+ *
+ * Return: 0, -1 if a write failed
+ */
+
+int _ring_close(buffer_t *output)
+{
+	uring_t *u = output->data;
+
+	_ring_submit(output);
+	_ring_wait(output, u->depth);
+	if (u->off >= 0)
+		lseek(output->fd, u->off, SEEK_SET);
+	munmap(u->sqes, u->sqes_size);
+	munmap(u->rings, u->rings_size);
+	close(u->ring);
+	_pool_put(u->block, (unsigned long int)output->size * u->depth);
+	output->start = NULL;
+	_pool_put(u, sizeof(uring_t));
+	return (output->error ? -1 : 0);
+}
@@ -0,0 +1,104 @@
+#include "main.h"
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+int _ring_setup(uring_t *u, unsigned int entries);
+int _ring_probe(int ring);
+long int _ring_finish(buffer_t *output, unsigned int slot, long int done);
+
+/**
+ * _ring_setup - creates the io_uring and maps its rings
+ * @u: state to fill in
+ * @entries: submission queue size
+ *
+ * Return: 0, -1 if io_uring or its write op is unavailable
+ */
+
+int _ring_setup(uring_t *u, unsigned int entries)
+{
+	struct io_uring_params p;
+	unsigned long int cq_size;
+
+	memset(&p, 0, sizeof(p));
+	u->ring = syscall(__NR_io_uring_setup, entries, &p);
+	if (u->ring < 0)
+		return (-1);
+	u->rings_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	u->rings_size = (cq_size > u->rings_size) ? cq_size : u->rings_size;
+	u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+	u->rings = mmap(NULL, u->rings_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, u->ring, IORING_OFF_SQ_RING);
+	u->sqes = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, u->ring, IORING_OFF_SQES);
+	if (!(p.features & IORING_FEAT_SINGLE_MMAP) || u->rings == MAP_FAILED ||
+			u->sqes == MAP_FAILED || _ring_probe(u->ring) < 0)
+	{
+		if (u->rings != MAP_FAILED)
+			munmap(u->rings, u->rings_size);
+		if (u->sqes != MAP_FAILED)
+			munmap(u->sqes, u->sqes_size);
+		close(u->ring);
+		return (-1);
+	}
+	u->sq_tail = (unsigned int *)(u->rings + p.sq_off.tail);
+	u->sq_mask = (unsigned int *)(u->rings + p.sq_off.ring_mask);
+	u->sq_array = (unsigned int *)(u->rings + p.sq_off.array);
+	u->cq_head = (unsigned int *)(u->rings + p.cq_off.head);
+	u->cq_tail = (unsigned int *)(u->rings + p.cq_off.tail);
+	u->cq_mask = (unsigned int *)(u->rings + p.cq_off.ring_mask);
+	u->cqes = (struct io_uring_cqe *)(u->rings + p.cq_off.cqes);
+	return (0);
+}
+
+/**
+ * _ring_probe - asks the kernel whether its io_uring has the write op,
+ * which came later than io_uring itself
+ * @ring: io_uring file descriptor
+ *
+ * Return: 0, -1 if it does not
+ */
+
+int _ring_probe(int ring)
+{
+	struct io_uring_probe_op mem[256 + sizeof(struct io_uring_probe) /
+		sizeof(struct io_uring_probe_op)];
+	struct io_uring_probe *probe = (struct io_uring_probe *)mem;
+
+	memset(mem, 0, sizeof(mem));
+	if (syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe,
+				256) < 0 || probe->last_op < IORING_OP_WRITE)
+		return (-1);
+	return ((probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED) ?
+			0 : -1);
+}
+
+/**
+ * _ring_finish - writes the part of a queued buffer the kernel left out
+ * after a short write, at the buffer's file offset if it has one
+ * @output: struct
+ * @slot: buffer
+ * @done: bytes the kernel wrote, negative errno if it failed
+ *
+ * Return: bytes of the buffer written, -1 on error
+ */
+
+long int _ring_finish(buffer_t *output, unsigned int slot, long int done)
+{
+	uring_t *u = output->data;
+	char *src = u->block + slot * output->size;
+	long int n;
+
+	while (done >= 0 && done < (long int)u->pending[slot])
+	{
+		n = u->pending[slot] - done;
+		n = (u->at[slot] < 0) ? write(output->fd, src + done, n) :
+			pwrite(output->fd, src + done, n, u->at[slot] + done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		done = (n > 0) ? done + n : -1;
+	}
+	return (done);
+}
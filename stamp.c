@@ -0,0 +1,157 @@
+#include "main.h"
+#include <time.h>
+
+int _printf_clock(int clock);
+char *_pair(char *dst, long int v);
+unsigned int _stamp_second(stamp_t *st, long int sec, int utc);
+unsigned int _stamp(char *dst, int utc, int digits);
+unsigned int _vtime(buffer_t *output, unsigned char flag, int width,
+		int precision);
+
+static int stamp_clock = STAMP_FINE;
+static __thread stamp_t stamps[2] = {{-1, 0, {0}, {0}}, {-1, 0, {0}, {0}}};
+
+/**
+ * _printf_clock - selects the clock %T reads
+ * @clock: STAMP_FINE for CLOCK_REALTIME, STAMP_COARSE for the cheaper
+ * CLOCK_REALTIME_COARSE (a few ms resolution) where there is one, -1 to
+ * only query
+ *
+ * Return: the previous clock
+ */
+
+int _printf_clock(int clock)
+{
+	int prev = __atomic_load_n(&stamp_clock, __ATOMIC_RELAXED);
+
+	if (clock == STAMP_FINE || clock == STAMP_COARSE)
+		__atomic_store_n(&stamp_clock, clock, __ATOMIC_RELAXED);
+	return (prev);
+}
+
+/**
+ * _pair - writes the last two decimal digits of a value
+ * @dst: 2 bytes
+ * @v: value, not negative
+ *
+ * Return: dst past the digits
+ */
+
+char *_pair(char *dst, long int v)
+{
+	dst[0] = '0' + v / 10 % 10;
+	dst[1] = '0' + v % 10;
+	return (dst + 2);
+}
+
+/**
+ * _stamp_second - formats the whole second part of a timestamp into the
+ * cache, the only place the calendar is worked out
+ * @st: cache of the calling thread
+ * @sec: seconds since the epoch
+ * @utc: 1 for UTC, 0 for local time
+ *
+ * Return: length of the zone suffix
+ */
+
+unsigned int _stamp_second(stamp_t *st, long int sec, int utc)
+{
+	time_t t = (time_t)sec;
+	struct tm tm;
+	long int off = 0;
+	int v[6], i;
+	char *p = st->text;
+
+	if (utc ? gmtime_r(&t, &tm) == NULL : localtime_r(&t, &tm) == NULL)
+		memset(&tm, 0, sizeof(tm));
+	v[0] = tm.tm_year + 1900;
+	v[1] = tm.tm_mon + 1;
+	v[2] = tm.tm_mday;
+	v[3] = tm.tm_hour;
+	v[4] = tm.tm_min;
+	v[5] = tm.tm_sec;
+	p = _pair(p, v[0] / 100);
+	for (i = 0; i < 6; i++)
+	{
+		p = _pair(p, v[i]);
+		*p++ = "--T::."[i];
+	}
+	if (!utc)
+		off = tm.tm_gmtoff / 60;
+	st->zn = 1;
+	st->zone[0] = utc ? 'Z' : (off < 0) ? '-' : '+';
+	off = (off < 0) ? -off : off;
+	if (!utc)
+	{
+		_pair(st->zone + 1, off / 60);
+		st->zone[3] = ':';
+		_pair(st->zone + 4, off % 60);
+		st->zn = 6;
+	}
+	st->sec = sec;
+	return (st->zn);
+}
+
+/**
+ * _stamp - formats the current time as ISO 8601, from a per thread cache
+ * of the text up to the second; within the same second only the fraction
+ * digits are written
+ * @dst: at least 36 bytes
+ * @utc: 1 for UTC with a Z suffix, 0 for local time with its offset
+ * @digits: fraction digits, 0 to 9
+ *
+ * Return: length of the timestamp
+ */
+
+unsigned int _stamp(char *dst, int utc, int digits)
+{
+	static const unsigned long int pow10[] = {1UL, 10UL, 100UL, 1000UL,
+		10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL,
+		1000000000UL};
+	stamp_t *st = &stamps[utc != 0];
+	struct timespec ts;
+	char frac[20];
+	unsigned int n = 19;
+	clockid_t id = CLOCK_REALTIME;
+
+#if defined(CLOCK_REALTIME_COARSE)
+	if (__atomic_load_n(&stamp_clock, __ATOMIC_RELAXED) == STAMP_COARSE)
+		id = CLOCK_REALTIME_COARSE;
+#endif
+	clock_gettime(id, &ts);
+	if (st->sec != (long int)ts.tv_sec)
+		_stamp_second(st, ts.tv_sec, utc != 0);
+	memcpy(dst, st->text, 20);
+	if (digits > 0)
+	{
+		_utoa(frac, pow10[digits] + ts.tv_nsec / pow10[9 - digits]);
+		memcpy(dst + 20, frac + 20 - digits, digits);
+		n += 1 + digits;
+	}
+	memcpy(dst + n, st->zone, st->zn);
+	return (n + st->zn);
+}
+
+/**
+ * _vtime - stores the current time as ISO 8601 with its width (%T)
+ * @output: struct
+ * @flag: flag, # for UTC
+ * @width: width
+ * @precision: fraction digits, 3 if -1, at most 9
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _vtime(buffer_t *output, unsigned char flag, int width,
+		int precision)
+{
+	char text[40];
+	unsigned int n, ret = 0;
+
+	precision = (precision < 0) ? 3 : (precision > 9) ? 9 : precision;
+	n = _stamp(text, HASH_FLAG, precision);
+	ret += print_width(output, n, flag, width);
+	ret += _memcpy(output, text, n);
+	ret += neg_width(output, ret, flag, width);
+	return (ret);
+}
@@ -0,0 +1,117 @@
+#include "main.h"
+
+printf_stats_t *_stats_self(void);
+void _stats_exit(void *unused);
+void _stats_add(printf_stats_t *to, const printf_stats_t *from);
+int _printf_stats(printf_stats_t *st, int all);
+
+static __thread stats_node_t mine;
+static stats_node_t *threads;
+static printf_stats_t gone;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t exit_key;
+static int keyed;
+
+/**
+ * _stats_self - counters of the calling thread, linked into the list
+ * _printf_stats reads on first use and unlinked when the thread exits;
+ * left out of the list if no exit key could unlink them
+ *
+ * Return: pointer to the counters
+ */
+
+printf_stats_t *_stats_self(void)
+{
+	if (mine.on)
+		return (&mine.st);
+	pthread_mutex_lock(&lock);
+	if (keyed == 0)
+		keyed = pthread_key_create(&exit_key, _stats_exit) ? -1 : 1;
+	mine.on = (keyed == 1 && pthread_setspecific(exit_key, &mine) == 0) ?
+		1 : -1;
+	if (mine.on == 1)
+	{
+		mine.prev = NULL;
+		mine.next = threads;
+		if (threads != NULL)
+			threads->prev = &mine;
+		threads = &mine;
+	}
+	pthread_mutex_unlock(&lock);
+	return (&mine.st);
+}
+
+/**
+ * _stats_exit - gives the pool blocks of an exiting thread back and
+ * folds its counters into those of the threads gone before
+ * @unused: key value
+ */
+
+void _stats_exit(void *unused)
+{
+	(void)unused;
+	_pool_drain(NULL);
+	if (mine.on != 1)
+		return;
+	pthread_mutex_lock(&lock);
+	if (mine.prev != NULL)
+		mine.prev->next = mine.next;
+	else
+		threads = mine.next;
+	if (mine.next != NULL)
+		mine.next->prev = mine.prev;
+	_stats_add(&gone, &mine.st);
+	memset(&mine.st, 0, sizeof(mine.st));
+	mine.on = 0;
+	pthread_mutex_unlock(&lock);
+}
+
+/**
+ * _stats_add - adds counters another thread may be writing to, the high
+ * water mark is the larger one
+ * @to: sum
+ * @from: counters
+ */
+
+void _stats_add(printf_stats_t *to, const printf_stats_t *from)
+{
+	unsigned long int high = __atomic_load_n(&from->high, __ATOMIC_RELAXED);
+	int i;
+
+	to->live += __atomic_load_n(&from->live, __ATOMIC_RELAXED);
+	to->cached += __atomic_load_n(&from->cached, __ATOMIC_RELAXED);
+	to->high = (high > to->high) ? high : to->high;
+	for (i = 0; i < FLUSH_REASONS; i++)
+		to->flushed[i] += __atomic_load_n(&from->flushed[i],
+				__ATOMIC_RELAXED);
+}
+
+/**
+ * _printf_stats - reads the memory and flush counters of the calling
+ * thread, or of the process: running threads plus those that exited
+ * @st: filled in
+ * @all: 0 for the calling thread, 1 for the process
+ *
+ * Return: no of running threads counted, -1 if st is NULL
+ */
+
+int _printf_stats(printf_stats_t *st, int all)
+{
+	stats_node_t *t;
+	int n = 0;
+
+	if (st == NULL)
+		return (-1);
+	memset(st, 0, sizeof(*st));
+	if (!all)
+	{
+		_stats_add(st, _stats_self());
+		return (1);
+	}
+	pthread_mutex_lock(&lock);
+	_stats_add(st, &gone);
+	for (t = threads; t != NULL; t = t->next, n++)
+		_stats_add(st, &t->st);
+	pthread_mutex_unlock(&lock);
+	return (n);
+}
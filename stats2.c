@@ -0,0 +1,45 @@
+#include "main.h"
+
+void _account(buffer_t *output, int why);
+int _record(buffer_t *output);
+
+/**
+ * _account - counts a write of the bytes a buffer holds, for the buffer
+ * and for its thread, before the sink makes it; not while the sink has
+ * pointed it elsewhere with a made-up len (a non-blocking stream's
+ * spill), those bytes are dropped, not written; a FLUSH_GROW writes
+ * nothing and leaves high alone
+ * @output: struct
+ * @why: FLUSH_FULL, FLUSH_EXPLICIT, FLUSH_END or FLUSH_GROW
+ */
+
+void _account(buffer_t *output, int why)
+{
+	printf_stats_t *st;
+
+	if (output->len == 0 || output->buffer != output->start + output->len)
+		return;
+	st = _stats_self();
+	if (why != FLUSH_GROW && output->len > output->high)
+		output->high = output->len;
+	if (why != FLUSH_GROW && output->len > st->high)
+		__atomic_store_n(&st->high, output->len, __ATOMIC_RELAXED);
+	output->flushed[why]++;
+	STAT_ADD(st->flushed[why], 1);
+}
+
+/**
+ * _record - ends the output of a call: counts it and hands it to the
+ * sink's commit, if the sink has one
+ * @output: struct
+ *
+ * Return: what commit returns, 0 without one
+ */
+
+int _record(buffer_t *output)
+{
+	if (output->sink->commit == NULL)
+		return (0);
+	_account(output, FLUSH_END);
+	return (output->sink->commit(output));
+}
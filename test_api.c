@@ -0,0 +1,110 @@
+#include "test_compare.h"
+
+/* the api checks, one line each in make test */
+static const api_t api[] = {
+	{"string sink", string_check},
+	{"memory sink", memory_check},
+	{"mmap sink", mmap_check},
+	{"callback sink", callback_check},
+	{"maplog sink, 4 threads", maplog_check},
+	{"_asprintf and _asprintf_alloc", asprintf_check},
+	{"_printf_batch", batch_check},
+	{"_printf_parallel matches _printf_batch", parallel_check},
+	{"_nb_batch on a pipe matches _printf_batch", nb_check},
+	{"_ctx_column", column_check},
+	{"_printf_limit sampling and bursts", limit_check},
+	{"coalescing sink and _printf_coalesce", coalesce_check},
+	{"%T timestamp shape", stamp_check},
+	{"_printf_buffered deadline and _printf_flush", deadline_check},
+	{NULL, NULL}
+};
+
+/**
+ * api_run - runs every api check and prints how each went
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int api_run(int fd)
+{
+	unsigned int k;
+	int failed = 0, f;
+
+	for (k = 0; api[k].what != NULL; k++)
+	{
+		f = api[k].run(fd);
+		printf("api: %s, %d failed\n", api[k].what, f);
+		failed += f;
+	}
+	return (failed);
+}
+
+/**
+ * same - compares the n bytes a check got with what it wants
+ * @what: the check
+ * @got: bytes
+ * @n: no of bytes, -1 if the call failed
+ * @want: NUL terminated
+ *
+ * Return: 0 if they match, 1 otherwise
+ */
+
+int same(const char *what, const char *got, long int n, const char *want)
+{
+	long int k = strlen(want);
+
+	if (n == k && memcmp(got, want, n) == 0)
+		return (0);
+	printf("FAIL %s\n", what);
+	printf("  want %5ld [%.*s]\n", k, k > 200 ? 200 : (int)k, want);
+	printf("  got  %5ld [%.*s]\n", n, n < 0 ? 0 : n > 200 ? 200 : (int)n,
+			got);
+	return (1);
+}
+
+/**
+ * grab - reads back what was written to the capture file and empties it
+ * @fd: capture file
+ * @buf: destination
+ * @size: size of buf
+ *
+ * Return: no of bytes read, -1 on error
+ */
+
+long int grab(int fd, char *buf, unsigned int size)
+{
+	ssize_t n = pread(fd, buf, size, 0);
+
+	if (ftruncate(fd, 0) < 0 || lseek(fd, 0, SEEK_SET) < 0)
+		return (-1);
+	return (n);
+}
+
+/**
+ * stdout_to - points fd 1 at a file, for calls that only write stdout
+ * @fd: file
+ *
+ * Return: copy of the old fd 1, for stdout_back
+ */
+
+int stdout_to(int fd)
+{
+	int saved;
+
+	fflush(stdout);
+	saved = dup(1);
+	dup2(fd, 1);
+	return (saved);
+}
+
+/**
+ * stdout_back - points fd 1 back where it was before stdout_to
+ * @saved: what stdout_to returned
+ */
+
+void stdout_back(int saved)
+{
+	dup2(saved, 1);
+	close(saved);
+}
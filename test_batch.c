@@ -0,0 +1,175 @@
+#include "test_compare.h"
+#include <stddef.h>
+#include <fcntl.h>
+
+#define ROWS 10000
+#define ROW_FORMAT "%d,%-6s,%j,%lu,%lB,%hd,%#x,%%\n"
+
+/* field of each ROW_FORMAT directive but %% */
+static const unsigned long int fields[] = {
+	offsetof(row_t, id), offsetof(row_t, name), offsetof(row_t, name),
+	offsetof(row_t, bytes), offsetof(row_t, bytes), offsetof(row_t, delta),
+	offsetof(row_t, id)
+};
+
+/**
+ * batch_want - fills the rows of the batch checks and formats them one
+ * _cprintf per row, which the fuzz and the fixed-output cases vouch for
+ * @rows: set to the rows
+ * @n: set to the length of the result
+ *
+ * Return: what a batch of the rows must print, free it, NULL on error
+ */
+
+char *batch_want(const row_t **rows, long int *n)
+{
+	static const char * const names[] = {"alpha", "b e t a", "q\"uo",
+		"", "tab\t", "longer than six"};
+	static row_t row[ROWS];
+	printf_ctx_t *ctx = _ctx_sink(_sink_string(0));
+	char *want;
+	int i;
+
+	if (ctx == NULL)
+		return (NULL);
+	for (i = 0; i < ROWS; i++)
+	{
+		row[i].id = i * 37 - 5000;
+		row[i].name = names[i % 6];
+		row[i].bytes = (unsigned long int)i * i * 1021;
+		row[i].delta = (short)(i * 13 - 600);
+		_cprintf(ctx, ROW_FORMAT, row[i].id, row[i].name, row[i].name,
+				row[i].bytes, row[i].bytes, row[i].delta,
+				row[i].id);
+	}
+	*n = (_close(ctx->output) < 0) ? -1 : (long int)ctx->output->len;
+	want = ctx->output->start;
+	ctx->output->start = NULL;
+	_ctx_close(ctx);
+	*rows = row;
+	return (want);
+}
+
+/**
+ * batch_check - _printf_batch prints the rows as _cprintf does
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int batch_check(int fd)
+{
+	const row_t *rows;
+	long int n, ret, got;
+	char *want = batch_want(&rows, &n), *cap = malloc(n + 1);
+	int saved, failed;
+
+	if (want == NULL || cap == NULL || n < 0)
+		failed = CHECK(0, "batch expected output");
+	else
+	{
+		grab(fd, cap, 0);
+		saved = stdout_to(fd);
+		ret = _printf_batch(ROW_FORMAT, rows, ROWS, sizeof(row_t),
+				fields);
+		stdout_back(saved);
+		got = grab(fd, cap, n + 1);
+		failed = CHECK(ret == n, "_printf_batch return");
+		failed += same("_printf_batch", cap, got, want);
+	}
+	free(want);
+	free(cap);
+	return (failed);
+}
+
+/**
+ * parallel_check - _printf_parallel prints the rows as _printf_batch
+ * does, on 2 workers (so in two rounds) and on one per CPU
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int parallel_check(int fd)
+{
+	const row_t *rows;
+	long int n, ret, got;
+	char *want = batch_want(&rows, &n), *cap = malloc(n + 1);
+	int failed = 0, workers;
+
+	if (want == NULL || cap == NULL || n < 0)
+		failed = CHECK(0, "parallel expected output");
+	for (workers = 2; failed == 0 && workers >= 0; workers -= 2)
+	{
+		grab(fd, cap, 0);
+		ret = _printf_parallel(fd, ROW_FORMAT, rows, ROWS,
+				sizeof(row_t), fields, workers);
+		got = grab(fd, cap, n + 1);
+		failed += CHECK(ret == n, "_printf_parallel return");
+		failed += same("_printf_parallel", cap, got, want);
+	}
+	free(want);
+	free(cap);
+	return (failed);
+}
+
+/**
+ * nb_check - _nb_batch over a non-blocking pipe read a little at a time
+ * stalls often, at varying points of the rows, and still prints what
+ * _printf_batch prints
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int nb_check(int fd)
+{
+	const row_t *rows;
+	long int n, got = 0, more;
+	char *want = batch_want(&rows, &n), *cap = malloc(n + 1);
+	fmt_op_t *ops = _printf_compile(ROW_FORMAT);
+	int pipes[2] = {-1, -1}, ret = -1, stalls = 0, failed;
+	nbstream_t *nb;
+
+	(void)fd;
+	if (want == NULL || cap == NULL || ops == NULL || n < 0 ||
+			pipe(pipes) < 0 || (nb = _nb_open(pipes[1], 0)) == NULL)
+		failed = CHECK(0, "nb setup");
+	else
+	{
+		fcntl(pipes[0], F_SETFL, O_NONBLOCK);
+		fcntl(pipes[1], F_SETFL, O_NONBLOCK);
+		ret = _nb_batch(nb, ops, rows, ROWS, sizeof(row_t), fields);
+		for (; ret == 1; stalls++, ret = _nb_resume(nb))
+			got = nb_drain(pipes[0], cap, got, n + 1);
+		failed = CHECK(ret == 0 && stalls > 0, "_nb_batch stalls");
+		failed += CHECK(_nb_close(nb) == 0, "_nb_close");
+		while ((more = nb_drain(pipes[0], cap, got, n + 1)) > got)
+			got = more;
+		failed += same("_nb_batch", cap, got, want);
+	}
+	close(pipes[0]);
+	close(pipes[1]);
+	free(ops);
+	free(want);
+	free(cap);
+	return (failed);
+}
+
+/**
+ * nb_drain - reads at most 777 bytes of what the pipe holds, so the
+ * writer stalls again soon and at a different point
+ * @fd: read end, non-blocking
+ * @buf: where the bytes read so far are
+ * @at: no of bytes read so far
+ * @size: size of buf
+ *
+ * Return: no of bytes read so far, after this read
+ */
+
+long int nb_drain(int fd, char *buf, long int at, long int size)
+{
+	ssize_t k = read(fd, buf + at, (size - at < 777) ? size - at : 777);
+
+	return ((k > 0) ? at + k : at);
+}
@@ -0,0 +1,64 @@
+#include "test_compare.h"
+
+/**
+ * column_check - _ctx_column prints each kind of column as glibc prints
+ * its values one by one
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int column_check(int fd)
+{
+	static const int ints[] = {0, 1, -1, 42, -42, 99999, INT_MAX, INT_MIN,
+		1000000, -7, 123456789, 5};
+	static const long int longs[] = {0, -1, LONG_MAX, LONG_MIN,
+		1234567890123L, -99};
+	static const short shorts[] = {0, -1, 32767, -32768, 12};
+	static const char * const strs[] = {"a", "", "column", "longer"};
+	char want[1024];
+	int i, failed;
+
+	(void)fd;
+	for (i = 0, *want = '\0'; i < 12; i++)
+		sprintf(want + strlen(want), "%8d\n", ints[i]);
+	failed = column_run("%8d\n", ints, 12, want);
+	for (i = 0, *want = '\0'; i < 12; i++)
+		sprintf(want + strlen(want), "[%-11u]", (unsigned int)ints[i]);
+	failed += column_run("[%-11u]", ints, 12, want);
+	for (i = 0, *want = '\0'; i < 6; i++)
+		sprintf(want + strlen(want), "%020ld,", longs[i]);
+	failed += column_run("%020ld,", longs, 6, want);
+	for (i = 0, *want = '\0'; i < 5; i++)
+		sprintf(want + strlen(want), "% hd;", shorts[i]);
+	failed += column_run("% hd;", shorts, 5, want);
+	for (i = 0, *want = '\0'; i < 4; i++)
+		sprintf(want + strlen(want), "<%5.4s>", strs[i]);
+	return (failed + column_run("<%5.4s>", strs, 4, want));
+}
+
+/**
+ * column_run - runs one column into a string sink and compares it
+ * @format: the column's directive and text
+ * @values: array
+ * @n: no of values
+ * @want: what it must print
+ *
+ * Return: 0 if it printed want, 1 otherwise
+ */
+
+int column_run(const char *format, const void *values, unsigned long int n,
+		const char *want)
+{
+	printf_ctx_t *ctx = _ctx_sink(_sink_string(0));
+	long int ret;
+	int failed;
+
+	if (ctx == NULL)
+		return (CHECK(0, "column sink"));
+	ret = _ctx_column(ctx, format, values, n);
+	_close(ctx->output);
+	failed = same(format, ctx->output->start, ret, want);
+	_ctx_close(ctx);
+	return (failed);
+}
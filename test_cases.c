@@ -0,0 +1,167 @@
+#include "test_compare.h"
+
+/**
+ * next - xorshift64 step
+ * @seed: state, never 0
+ *
+ * Return: next value
+ */
+
+unsigned long int next(unsigned long int *seed)
+{
+	*seed ^= *seed << 13;
+	*seed ^= *seed >> 7;
+	*seed ^= *seed << 17;
+	return (*seed);
+}
+
+/**
+ * gen_case - builds a random directive between random literal text, only
+ * with specifiers, flags and modifiers whose result the C standard defines
+ * @c: filled in
+ * @seed: random state
+ */
+
+void gen_case(case_t *c, unsigned long int *seed)
+{
+	static const char specs[] = "csdiuoxXp%";
+	static const char text[] = "ab c:=\t-[]{}XYZ.";
+	char spec = specs[next(seed) % 10], *f = c->fmt;
+	int n;
+
+	c->stars = 0;
+	n = next(seed) % 6;
+	memcpy(f, text + next(seed) % 10, n);
+	f += n;
+	*f++ = '%';
+	if (spec != '%')
+		f = gen_spec(f, spec, c, seed);
+	*f++ = spec;
+	n = next(seed) % 6;
+	memcpy(f, text + next(seed) % 10, n);
+	f[n] = '\0';
+	gen_value(c, spec, seed);
+}
+
+/**
+ * gen_spec - writes the flags, width, precision and length of a directive
+ * @f: where to write
+ * @spec: conversion specifier
+ * @c: case, stars are filled in
+ * @seed: random state
+ *
+ * Return: pointer past what was written
+ */
+
+char *gen_spec(char *f, char spec, case_t *c, unsigned long int *seed)
+{
+	static const char * const lens[] = {"", "", "h", "l", "hh", "ll", ""};
+	const char *flags = strchr("di", spec) ? "+- 0" :
+		strchr("uoxXp", spec) ? "+- #0" : "-";
+	unsigned long int r = next(seed);
+	int k;
+
+	for (k = 0; flags[k]; k++)
+		if ((r >> (2 * k)) % 3 == 0 && (spec != 'u' || flags[k] != '#'))
+			*f++ = flags[k];
+	r = next(seed);
+	if (r % 4 == 1)
+		f += sprintf(f, "%d", (int)(r / 4 % 31));
+	if (r % 4 == 2)
+	{
+		*f++ = '*';
+		c->star[c->stars++] = (int)(r / 4 % 61) - 30;
+	}
+	r = next(seed);
+	if (strchr("cp", spec) == NULL && r % 4 != 0)
+		*f++ = '.';
+	if (strchr("cp", spec) == NULL && r % 4 == 2)
+		f += sprintf(f, "%d", (int)(r / 4 % 26));
+	if (strchr("cp", spec) == NULL && r % 4 == 3)
+	{
+		*f++ = '*';
+		c->star[c->stars++] = (int)(r / 4 % 41) - 10;
+	}
+	if (strchr("diuoxX", spec))
+		f += sprintf(f, "%s", lens[next(seed) % 7]);
+	return (f);
+}
+
+/**
+ * gen_value - picks the argument of a case: edge values half the time,
+ * otherwise random values of random magnitude
+ * @c: case, fmt already written
+ * @spec: conversion specifier
+ * @seed: random state
+ */
+
+void gen_value(case_t *c, char spec, unsigned long int *seed)
+{
+	static const long int edge[] = {0, 1, -1, 7, -7, 10, 99, 100, -128,
+		255, 32767, -32768, 65535, INT_MAX, INT_MIN, UINT_MAX, LONG_MAX,
+		LONG_MIN};
+	static const char * const strs[] = {"", "a", "hello", "hello, world",
+		"tab\there", NULL, "0123456789abcdefghij", "\xc3\xa9t\xc3\xa9"};
+	unsigned long int r = next(seed);
+	int l = (strchr(c->fmt, 'l') != NULL) + (strstr(c->fmt, "ll") != NULL);
+
+	c->v = (r % 2) ? edge[r / 2 % 18] :
+		(long int)(next(seed) >> (r / 2 % 64));
+	c->v = (next(seed) % 2) ? (long int)(0UL - c->v) : c->v;
+	c->cls = strchr("di", spec) ? CLS_INT + 2 * l :
+		strchr("uoxX", spec) ? CLS_UINT + 2 * l : CLS_INT;
+	if (spec == 'c')
+		c->v = 1 + r % 255;
+	if (spec == 's' || spec == 'p')
+		c->cls = CLS_PTR;
+	c->s = (spec == 's') ? strs[r % 8] :
+		(const char *)(c->v * (r % 3 != 0));
+}
+
+/**
+ * known_case - copies regression case k, one the fuzzer once found
+ * @c: filled in
+ * @k: index
+ *
+ * Return: 1, 0 past the last case
+ */
+
+int known_case(case_t *c, unsigned int k)
+{
+	static const case_t known[] = {
+		{"[%d]", CLS_INT, 0, {0, 0}, 42, NULL},
+		{"[%s]", CLS_PTR, 0, {0, 0}, 0, "hello"},
+		{"[%*d]", CLS_INT, 1, {-6, 0}, 42, NULL},
+		{"[%.*d]", CLS_INT, 1, {-3, 0}, 7, NULL},
+		{"[%*.*x]", CLS_UINT, 2, {-5, -1}, 255, NULL},
+		{"[%5c]", CLS_INT, 0, {0, 0}, 65, NULL},
+		{"[%*c]", CLS_INT, 1, {3, 0}, 66, NULL},
+		{"[%-8s]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%8s]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%.3s]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%7p]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%+ d]", CLS_INT, 0, {0, 0}, 99, NULL},
+		{"[% +5d]", CLS_INT, 0, {0, 0}, 7, NULL},
+		{"[%-05d]", CLS_INT, 0, {0, 0}, -5, NULL},
+		{"[%0.3d]", CLS_INT, 0, {0, 0}, -24, NULL},
+		{"[%8.3d]", CLS_INT, 0, {0, 0}, -5, NULL},
+		{"[%-8.3d]", CLS_INT, 0, {0, 0}, 42, NULL},
+		{"[%05.0d]", CLS_INT, 0, {0, 0}, 0, NULL},
+		{"[%#10x]", CLS_UINT, 0, {0, 0}, 255, NULL},
+		{"[%-#8X]", CLS_UINT, 0, {0, 0}, 48879, NULL},
+		{"[%#6o]", CLS_UINT, 0, {0, 0}, 8, NULL},
+		{"[%#010x]", CLS_UINT, 0, {0, 0}, 26, NULL},
+		{"[%#.5o]", CLS_UINT, 0, {0, 0}, 8, NULL},
+		{"[%#.0o]", CLS_UINT, 0, {0, 0}, 0, NULL},
+		{"[%#08.6o]", CLS_UINT, 0, {0, 0}, 128, NULL},
+		{"[%-8ls]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%8ls]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"[%.3ls]", CLS_PTR, 0, {0, 0}, 0, NULL},
+		{"", 0, 0, {0, 0}, 0, NULL}
+	};
+
+	if (known[k].fmt[0] == '\0')
+		return (0);
+	*c = known[k];
+	return (1);
+}
@@ -0,0 +1,198 @@
+#include "test_compare.h"
+
+#define CASES 100000
+#define SHOWN 20
+
+/* emits a case's value after the * arguments its directive reads */
+#define PASS(v) ((c->stars == 0) ? emit(who, buf, size, c->fmt, v) : \
+	(c->stars == 1) ? emit(who, buf, size, c->fmt, w, v) : \
+	emit(who, buf, size, c->fmt, w, p, v))
+
+int emit(int who, char *buf, unsigned int size, const char *fmt, ...);
+int check(const case_t *c, int fd);
+int pool_check(int fd);
+
+/**
+ * emit - formats with glibc (0), with _vcprintf into a memory sink (1)
+ * or with _vprintf on fd 1 redirected to the capture file (2)
+ * @who: 0, 1 or 2
+ * @buf: destination for 0 and 1, capture fd for 2 in buf[0..3]
+ * @size: size of buf
+ * @fmt: format
+ *
+ * Return: what the printf returned
+ */
+
+int emit(int who, char *buf, unsigned int size, const char *fmt, ...)
+{
+	printf_ctx_t *ctx;
+	va_list ap;
+	int ret = -1, out, fd;
+
+	va_start(ap, fmt);
+	if (who == 0)
+		ret = vsnprintf(buf, size, fmt, ap);
+	else if (who == 1)
+	{
+		ctx = _ctx_sink(_sink_memory(buf, size));
+		ret = (ctx == NULL) ? -1 : _vcprintf(ctx, fmt, ap);
+		if (ctx != NULL && _ctx_close(ctx) < 0)
+			ret = -1;
+	}
+	else
+	{
+		memcpy(&fd, buf, sizeof(fd));
+		fflush(stdout);
+		out = dup(1);
+		dup2(fd, 1);
+		ret = _vprintf(fmt, ap);
+		dup2(out, 1);
+		close(out);
+	}
+	va_end(ap);
+	return (ret);
+}
+
+/**
+ * call - passes a case's arguments with the types its directive reads
+ * @who: see emit
+ * @buf: see emit
+ * @size: see emit
+ * @c: case
+ *
+ * Return: what the printf returned
+ */
+
+int call(int who, char *buf, unsigned int size, const case_t *c)
+{
+	int i = (int)c->v, w = c->star[0], p = c->star[1];
+	unsigned int u = (unsigned int)c->v;
+	unsigned long int ul = (unsigned long int)c->v;
+	llong_t ll = (llong_t)c->v;
+	ullong_t ull = (ullong_t)c->v;
+
+	switch (c->cls)
+	{
+	case CLS_INT:
+		return (PASS(i));
+	case CLS_UINT:
+		return (PASS(u));
+	case CLS_LONG:
+		return (PASS(c->v));
+	case CLS_ULONG:
+		return (PASS(ul));
+	case CLS_LLONG:
+		return (PASS(ll));
+	case CLS_ULLONG:
+		return (PASS(ull));
+	}
+	return (PASS(c->s));
+}
+
+/**
+ * check - runs a case through glibc, the memory sink and _printf on a
+ * captured fd, and reports any difference in bytes or return value
+ * @c: case
+ * @fd: capture file
+ *
+ * Return: 0 if all three agree, 1 otherwise
+ */
+
+int check(const case_t *c, int fd)
+{
+	char want[512], got[512], cap[512];
+	int n, m, k;
+	ssize_t read_back;
+
+	n = call(0, want, sizeof(want), c);
+	m = call(1, got, sizeof(got), c);
+	if (ftruncate(fd, 0) < 0 || lseek(fd, 0, SEEK_SET) < 0)
+		return (1);
+	memcpy(cap, &fd, sizeof(fd));
+	k = call(2, cap, sizeof(cap), c);
+	read_back = pread(fd, cap, sizeof(cap), 0);
+	if (n == m && n == k && n == read_back && n >= 0 &&
+			memcmp(want, got, n) == 0 && memcmp(want, cap, n) == 0)
+		return (0);
+	printf("FAIL \"%s\" stars %d %d value %ld/%p\n", c->fmt, c->star[0],
+			c->star[1], c->v, (void *)c->s);
+	printf("  glibc  %3d [%.*s]\n", n, n < 0 ? 0 : n, want);
+	printf("  memory %3d [%.*s]\n", m, m < 0 ? 0 : m, got);
+	printf("  fd     %3d [%.*s]\n", k, read_back < 0 ? 0 : (int)read_back,
+			cap);
+	return (1);
+}
+
+/**
+ * pool_check - opens, uses and closes a uring context and checks the
+ * pool got back every byte it handed out
+ * @fd: file to write to
+ *
+ * Return: 0 if live is back where it started, 1 otherwise
+ */
+
+int pool_check(int fd)
+{
+	printf_stats_t before, after;
+	printf_ctx_t *ctx;
+	int i;
+
+	_printf_stats(&before, 0);
+	ctx = _ctx_sink(_sink_uring(fd, 0, 4));
+	if (ctx == NULL)
+		return (1);
+	for (i = 0; i < 10000; i++)
+		_cprintf(ctx, "%d %s\n", i, "uring");
+	_ctx_close(ctx);
+	_printf_stats(&after, 0);
+	printf("pool: uring context, live %ld -> %ld\n", before.live,
+			after.live);
+	return (after.live != before.live);
+}
+
+/**
+ * main - the known regression cases, the fixed-output cases of the
+ * custom specifiers and a differential fuzz of _printf against glibc,
+ * the api checks of test_api.c, then the ns/op regression check of
+ * test_perf.c
+ * @argc: no of args
+ * @argv: [cases [seed]]
+ *
+ * Return: 0 when everything passed, 1 otherwise
+ */
+
+int main(int argc, char **argv)
+{
+	unsigned long int seed = 0x9e3779b97f4a7c15UL, cases = CASES, i;
+	unsigned long int failed = 0, known;
+	FILE *capture = tmpfile();
+	const char *want;
+	unsigned int k;
+	case_t c;
+
+	if (argc > 1)
+		cases = strtoul(argv[1], NULL, 10);
+	if (argc > 2)
+		seed = strtoul(argv[2], NULL, 10) | 1;
+	if (capture == NULL)
+		return (1);
+	for (k = 0; known_case(&c, k); k++)
+		failed += check(&c, fileno(capture));
+	printf("known: %u regression cases, %lu failed\n", k, failed);
+	for (known = failed, k = 0; expect_case(&c, &want, k); k++)
+		failed += expect_check(&c, want, fileno(capture));
+	printf("expect: %u fixed-output cases, %lu failed\n", k,
+			failed - known);
+	for (i = 0; i < cases && failed < SHOWN; i++)
+	{
+		gen_case(&c, &seed);
+		failed += check(&c, fileno(capture));
+	}
+	printf("fuzz: %lu cases against glibc, %lu failed\n", i, failed);
+	failed += pool_check(fileno(capture));
+	failed += api_run(fileno(capture));
+	fclose(capture);
+	if (perf_run() != 0)
+		failed++;
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,119 @@
+#ifndef TEST_COMPARE_H
+#define TEST_COMPARE_H
+
+#include "main.h"
+#include <stdio.h>
+#include <time.h>
+
+/* argument classes of a generated case */
+#define CLS_INT 0
+#define CLS_UINT 1
+#define CLS_LONG 2
+#define CLS_ULONG 3
+#define CLS_LLONG 4
+#define CLS_ULLONG 5
+#define CLS_PTR 6
+
+/* 0 if ok holds, otherwise says which check failed and gives 1 */
+#define CHECK(ok, what) ((ok) ? 0 : (printf("FAIL %s\n", (what)), 1))
+
+/* what ll reads; long long is an extension in C89 */
+__extension__ typedef long long int llong_t;
+__extension__ typedef unsigned long long int ullong_t;
+
+/**
+ * struct case_s - one generated call, a directive between literal text
+ * @fmt: format
+ * @cls: CLS_* type the directive reads
+ * @stars: no of * ints passed before the value
+ * @star: the * values, width first
+ * @v: value of the integer classes, address for CLS_PTR
+ * @s: value of CLS_PTR
+ */
+typedef struct case_s
+{
+	char fmt[64];
+	int cls;
+	int stars;
+	int star[2];
+	long int v;
+	const char *s;
+} case_t;
+
+/**
+ * struct expect_s - a call glibc has no counterpart for, with the bytes
+ * it must print
+ * @c: the call
+ * @want: its output
+ */
+typedef struct expect_s
+{
+	case_t c;
+	const char *want;
+} expect_t;
+
+/**
+ * struct api_s - checks of one feature's calls, whose output is known
+ * @what: the feature
+ * @run: runs them with the capture file, returns the no that failed
+ */
+typedef struct api_s
+{
+	const char *what;
+	int (*run)(int fd);
+} api_t;
+
+/**
+ * struct row_s - record of the batch checks
+ * @id: %d and %#x
+ * @name: %-6s and %j
+ * @bytes: %lu and %lB
+ * @delta: %hd
+ */
+typedef struct row_s
+{
+	int id;
+	const char *name;
+	unsigned long int bytes;
+	short delta;
+} row_t;
+
+int call(int who, char *buf, unsigned int size, const case_t *c);
+unsigned long int next(unsigned long int *seed);
+void gen_case(case_t *c, unsigned long int *seed);
+char *gen_spec(char *f, char spec, case_t *c, unsigned long int *seed);
+void gen_value(case_t *c, char spec, unsigned long int *seed);
+int known_case(case_t *c, unsigned int k);
+int expect_case(case_t *c, const char **want, unsigned int k);
+int expect_check(const case_t *c, const char *want, int fd);
+int api_run(int fd);
+int same(const char *what, const char *got, long int n, const char *want);
+long int grab(int fd, char *buf, unsigned int size);
+int stdout_to(int fd);
+void stdout_back(int saved);
+int string_check(int fd);
+int memory_check(int fd);
+int mmap_check(int fd);
+int callback_check(int fd);
+int cb_append(void *arg, const char *buf, unsigned int n);
+int maplog_check(int fd);
+void *maplog_writer(void *log);
+int maplog_verify(const char *path);
+int asprintf_check(int fd);
+char *batch_want(const row_t **rows, long int *n);
+int batch_check(int fd);
+int parallel_check(int fd);
+int nb_check(int fd);
+long int nb_drain(int fd, char *buf, long int at, long int size);
+int column_check(int fd);
+int limit_check(int fd);
+int coalesce_check(int fd);
+int stamp_shape(const char *got, const char *shape);
+int stamp_check(int fd);
+int deadline_check(int fd);
+int column_run(const char *format, const void *values, unsigned long int n,
+		const char *want);
+int perf_run(void);
+double perf_case(int who, const char *fmt, FILE *libc, printf_ctx_t *ctx);
+
+#endif
@@ -0,0 +1,138 @@
+#include "test_compare.h"
+
+/* the fixed-output cases, custom specifiers and flags by request */
+static const expect_t expect[] = {
+	{{"[%S]", CLS_PTR, 0, {0, 0}, 0, "A\x01z\n\x7f\xff"},
+		"[A\\x01z\\x0A\\x7F\\xFF]"},
+	{{"[%.3S]", CLS_PTR, 0, {0, 0}, 0, "ab\x02zz"}, "[ab\\x02]"},
+	{{"[%10S]", CLS_PTR, 0, {0, 0}, 0, "a\tb"}, "[       a\\x09b]"},
+	{{"[%S]", CLS_PTR, 0, {0, 0}, 0, "0123456789abcdef\x1f"
+		"0123456789abcdef"}, "[0123456789abcdef\\x1F"
+		"0123456789abcdef]"},
+	{{"[%S]", CLS_PTR, 0, {0, 0}, 0, NULL}, "[(null)]"},
+	{{"[%R]", CLS_PTR, 0, {0, 0}, 0, "Hello, World!"},
+		"[Uryyb, Jbeyq!]"},
+	{{"[%R]", CLS_PTR, 0, {0, 0}, 0, "abcdefghijklmnopqrstuvwxyz"
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ"}, "[nopqrstuvwxyzabcdefghijklm"
+		"NOPQRSTUVWXYZABCDEFGHIJKLM]"},
+	{{"[%.5R]", CLS_PTR, 0, {0, 0}, 0, "abcdefgh"}, "[nopqr]"},
+	{{"[%-8R]", CLS_PTR, 0, {0, 0}, 0, "az"}, "[nm      ]"},
+	{{"[%R]", CLS_PTR, 0, {0, 0}, 0, NULL}, "[(null)]"},
+	{{"[%r]", CLS_PTR, 0, {0, 0}, 0, "hello"}, "[olleh]"},
+	{{"[%.3r]", CLS_PTR, 0, {0, 0}, 0, "hello"}, "[oll]"},
+	{{"[%7r]", CLS_PTR, 0, {0, 0}, 0, "abc"}, "[    cba]"},
+	{{"[%-7r]", CLS_PTR, 0, {0, 0}, 0, "abc"}, "[cba    ]"},
+	{{"[%r]", CLS_PTR, 0, {0, 0}, 0, ""}, "[]"},
+	{{"[%r]", CLS_PTR, 0, {0, 0}, 0, "0123456789abcdefghijklmnopqrstuv"
+		"wxyzABCDEFGHIJ"}, "[JIHGFEDCBAzyxwvutsrqponmlkjihgfedcba"
+		"9876543210]"},
+	{{"[%r]", CLS_PTR, 0, {0, 0}, 0, NULL}, "[(null)]"},
+	{{"[%j]", CLS_PTR, 0, {0, 0}, 0, "a\"b\\c\n\x01"},
+		"[\"a\\\"b\\\\c\\n\\u0001\"]"},
+	{{"[%j]", CLS_PTR, 0, {0, 0}, 0, "tab\there\r\b\f/"},
+		"[\"tab\\there\\r\\b\\f/\"]"},
+	{{"[%j]", CLS_PTR, 0, {0, 0}, 0, "0123456789abcdef0123456789\"ab"},
+		"[\"0123456789abcdef0123456789\\\"ab\"]"},
+	{{"[%.2j]", CLS_PTR, 0, {0, 0}, 0, "abcdef"}, "[\"ab\"]"},
+	{{"[%10j]", CLS_PTR, 0, {0, 0}, 0, "ab"}, "[\"ab\"]"},
+	{{"[%j]", CLS_PTR, 0, {0, 0}, 0, NULL}, "[null]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, "plain"}, "[plain]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, "a b"}, "[\"a b\"]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, "a=b"}, "[\"a=b\"]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, "q\"x\n"}, "[\"q\\\"x\\n\"]"},
+	{{"[%.3J]", CLS_PTR, 0, {0, 0}, 0, "a b c"}, "[\"a b\"]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, ""}, "[\"\"]"},
+	{{"[%J]", CLS_PTR, 0, {0, 0}, 0, NULL}, "[\"\"]"},
+	{{"[%'d]", CLS_INT, 0, {0, 0}, 1234567, NULL}, "[1,234,567]"},
+	{{"[%'d]", CLS_INT, 0, {0, 0}, -1234567, NULL}, "[-1,234,567]"},
+	{{"[%'d]", CLS_INT, 0, {0, 0}, 999, NULL}, "[999]"},
+	{{"[%'u]", CLS_UINT, 0, {0, 0}, 4294967295UL, NULL},
+		"[4,294,967,295]"},
+	{{"[%'12d]", CLS_INT, 0, {0, 0}, 1234567, NULL}, "[   1,234,567]"},
+	{{"[%'-12d]", CLS_INT, 0, {0, 0}, 1234, NULL}, "[1,234       ]"},
+	{{"[%'012d]", CLS_INT, 0, {0, 0}, 1234567, NULL}, "[0001,234,567]"},
+	{{"[%'.7d]", CLS_INT, 0, {0, 0}, 1234, NULL}, "[0001,234]"},
+	{{"[%'ld]", CLS_LONG, 0, {0, 0}, LONG_MIN, NULL},
+		"[-9,223,372,036,854,775,808]"},
+	{{"[%B]", CLS_UINT, 0, {0, 0}, 0, NULL}, "[0 B]"},
+	{{"[%B]", CLS_UINT, 0, {0, 0}, 1023, NULL}, "[1023 B]"},
+	{{"[%B]", CLS_UINT, 0, {0, 0}, 1536, NULL}, "[1.5 KiB]"},
+	{{"[%#B]", CLS_UINT, 0, {0, 0}, 1500, NULL}, "[1.5 kB]"},
+	{{"[%lB]", CLS_ULONG, 0, {0, 0}, 5368709120L, NULL}, "[5.0 GiB]"},
+	{{"[%.2B]", CLS_UINT, 0, {0, 0}, 1536, NULL}, "[1.50 KiB]"},
+	{{"[%10B]", CLS_UINT, 0, {0, 0}, 1536, NULL}, "[   1.5 KiB]"},
+	{{"[%-10B]", CLS_UINT, 0, {0, 0}, 2048, NULL}, "[2.0 KiB   ]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, 0, NULL}, "[0ns]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, 850, NULL}, "[850ns]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, 12500, NULL}, "[12.5us]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, 1500000, NULL}, "[1.5ms]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, 1500000000, NULL}, "[1.5s]"},
+	{{"[%D]", CLS_INT, 0, {0, 0}, -1500, NULL}, "[-1.5us]"},
+	{{"[%lD]", CLS_LONG, 0, {0, 0}, 125000000000L, NULL}, "[2m05s]"},
+	{{"[%lD]", CLS_LONG, 0, {0, 0}, 266400000000000L, NULL}, "[3d02h]"},
+	{{"[%b]", CLS_UINT, 0, {0, 0}, 5, NULL}, "[101]"},
+	{{"[%#b]", CLS_UINT, 0, {0, 0}, 5, NULL}, "[0b101]"},
+	{{"[%08b]", CLS_UINT, 0, {0, 0}, 5, NULL}, "[00000101]"},
+	{{"[%-6b]", CLS_UINT, 0, {0, 0}, 5, NULL}, "[101   ]"},
+	{{"[%hhb]", CLS_UINT, 0, {0, 0}, 0x1ff, NULL}, "[11111111]"},
+	{{"[%'b]", CLS_UINT, 0, {0, 0}, 0xaf, NULL}, "[1010_1111]"},
+	{{"[%'lb]", CLS_ULONG, 0, {0, 0}, 0x12345L, NULL},
+		"[1_0010_0011_0100_0101]"},
+	{{"[%lb]", CLS_ULONG, 0, {0, 0}, 1L << 40, NULL},
+		"[10000000000000000000000000000000000000000]"},
+	{{"", 0, 0, {0, 0}, 0, NULL}, NULL}
+};
+
+/**
+ * expect_case - copies fixed-output case k, a custom specifier or flag
+ * glibc can't be asked about
+ * @c: filled in
+ * @want: set to the bytes c must print
+ * @k: index
+ *
+ * Return: 1, 0 past the last case
+ */
+
+int expect_case(case_t *c, const char **want, unsigned int k)
+{
+	if (expect[k].want == NULL)
+		return (0);
+	*c = expect[k].c;
+	*want = expect[k].want;
+	return (1);
+}
+
+/**
+ * expect_check - runs a fixed-output case through the memory sink and
+ * _printf on a captured fd, and reports bytes or a return value that
+ * differ from what it must print
+ * @c: case
+ * @want: its output
+ * @fd: capture file
+ *
+ * Return: 0 if both print want, 1 otherwise
+ */
+
+int expect_check(const case_t *c, const char *want, int fd)
+{
+	char got[512], cap[512];
+	int n = strlen(want), m, k;
+	ssize_t read_back;
+
+	m = call(1, got, sizeof(got), c);
+	if (ftruncate(fd, 0) < 0 || lseek(fd, 0, SEEK_SET) < 0)
+		return (1);
+	memcpy(cap, &fd, sizeof(fd));
+	k = call(2, cap, sizeof(cap), c);
+	read_back = pread(fd, cap, sizeof(cap), 0);
+	if (n == m && n == k && n == read_back &&
+			memcmp(want, got, n) == 0 && memcmp(want, cap, n) == 0)
+		return (0);
+	printf("FAIL \"%s\" stars %d %d value %ld/%p\n", c->fmt, c->star[0],
+			c->star[1], c->v, (void *)c->s);
+	printf("  want   %3d [%s]\n", n, want);
+	printf("  memory %3d [%.*s]\n", m, m < 0 ? 0 : m, got);
+	printf("  fd     %3d [%.*s]\n", k, read_back < 0 ? 0 : (int)read_back,
+			cap);
+	return (1);
+}
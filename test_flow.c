@@ -0,0 +1,170 @@
+#include "test_compare.h"
+
+/**
+ * limit_check - with 1 call in 10 sampled a site prints calls 0, 10, ..
+ * and with a burst of 5 at 1 line a second, its first 5 calls; then
+ * _printf_suppressed reports the rest, in the order of the sites' slots
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int limit_check(int fd)
+{
+	static const char sampled[] = "s%d ", burst[] = "b%d ";
+	static const char * const report[] = {
+		"_printf: suppressed 90 calls of \"s%d \"\n",
+		"_printf: suppressed 15 calls of \"b%d \"\n"};
+	char got[512];
+	int i, saved, failed;
+	long int n;
+
+	grab(fd, got, 0);
+	saved = stdout_to(fd);
+	_printf_limit(0, 0, 10);
+	for (i = 0; i < 100; i++)
+		_printf(sampled, i);
+	_printf_limit(1, 5, 0);
+	for (i = 0; i < 20; i++)
+		_printf(burst, i);
+	_printf_limit(0, 0, 0);
+	stdout_back(saved);
+	n = grab(fd, got, sizeof(got));
+	failed = same("_printf_limit", got, n, "s0 s10 s20 s30 s40 s50 s60 "
+			"s70 s80 s90 b0 b1 b2 b3 b4 ");
+	failed += CHECK(_printf_suppressed(fd) == 105, "_printf_suppressed");
+	n = grab(fd, got, sizeof(got) - 1);
+	got[n < 0 ? 0 : n] = '\0';
+	return (failed + CHECK(n == (long int)(strlen(report[0]) +
+				strlen(report[1])) && strstr(got, report[0]) &&
+			strstr(got, report[1]),
+			"_printf_suppressed report, in either site order"));
+}
+
+/**
+ * coalesce_check - runs of one record collapse into a count line, written
+ * when another record comes, on _ctx_flush and when coalescing stops
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int coalesce_check(int fd)
+{
+	printf_ctx_t *ctx = _ctx_sink(_sink_coalesce(fd, 0));
+	char got[512];
+	int i, saved, failed;
+	long int n;
+
+	if (ctx == NULL)
+		return (CHECK(0, "coalescing sink"));
+	grab(fd, got, 0);
+	for (i = 0; i < 5; i++)
+		_cprintf(ctx, "same %s\n", "line");
+	_cprintf(ctx, "other\n");
+	_cprintf(ctx, "same line\n");
+	for (i = 0; i < 3; i++)
+		_cprintf(ctx, "x%d\n", 1);
+	_ctx_flush(ctx);
+	_cprintf(ctx, "x1\n");
+	failed = CHECK(_ctx_close(ctx) == 0, "coalescing sink close");
+	n = grab(fd, got, sizeof(got));
+	failed += same("coalescing sink", got, n, "same line\n"
+			"last message repeated 4 times\nother\nsame line\nx1\n"
+			"last message repeated 2 times\nx1\n");
+	saved = stdout_to(fd);
+	_printf_coalesce(1);
+	for (i = 0; i < 4; i++)
+		_printf("%s\n", (i < 3) ? "p" : "q");
+	_printf("q\n");
+	_printf_coalesce(0);
+	stdout_back(saved);
+	n = grab(fd, got, sizeof(got));
+	return (failed + same("_printf_coalesce", got, n, "p\n"
+			"last message repeated 2 times\nq\n"
+			"last message repeated 1 times\n"));
+}
+
+/**
+ * stamp_shape - matches text against a shape where 9 stands for any digit
+ * @got: text
+ * @shape: shape, other characters match themselves
+ *
+ * Return: 1 if it matches
+ */
+
+int stamp_shape(const char *got, const char *shape)
+{
+	for (; *shape != '\0'; got++, shape++)
+		if (*shape == '9' ? *got < '0' || *got > '9' : *got != *shape)
+			return (0);
+	return (*got == '\0');
+}
+
+/**
+ * stamp_check - %T depends on the clock, so check the shape of the UTC
+ * forms at each precision and that the year is the current one
+ * @fd: capture file, unused
+ *
+ * Return: no of checks that failed
+ */
+
+int stamp_check(int fd)
+{
+	char *got = NULL, year[8];
+	time_t now = time(NULL);
+	struct tm tm;
+	int failed;
+
+	(void)fd;
+	if (_asprintf(&got, "%#T|%#.0T|%#.9T") != 76)
+		failed = CHECK(0, "%#T|%#.0T|%#.9T length");
+	else
+		failed = CHECK(stamp_shape(got, "9999-99-99T99:99:99.999Z|"
+				"9999-99-99T99:99:99Z|"
+				"9999-99-99T99:99:99.999999999Z"), "%T shape");
+	gmtime_r(&now, &tm);
+	strftime(year, sizeof(year), "%Y-", &tm);
+	failed += CHECK(got != NULL && strncmp(got, year, 5) == 0, "%T year");
+	free(got);
+	return (failed);
+}
+
+/**
+ * deadline_check - with a deadline on, _printf holds its bytes back until
+ * _printf_flush or until the flush thread finds them ms old
+ * @fd: capture file
+ *
+ * Return: no of checks that failed
+ */
+
+int deadline_check(int fd)
+{
+	struct timespec tick = {0, 10000000};
+	char got[64];
+	int i, saved, failed;
+	long int n;
+
+	grab(fd, got, 0);
+	saved = stdout_to(fd);
+	failed = CHECK(_printf_buffered(200) == 0, "_printf_buffered on");
+	_printf("held %d\n", 1);
+	n = grab(fd, got, sizeof(got));
+	failed += same("_printf held back", got, n, "");
+	_printf_flush();
+	n = grab(fd, got, sizeof(got));
+	failed += same("_printf_flush", got, n, "held 1\n");
+	_printf("late\n");
+	n = grab(fd, got, sizeof(got));
+	for (i = 0; n == 0 && i < 300; i++)
+	{
+		nanosleep(&tick, NULL);
+		n = grab(fd, got, sizeof(got));
+	}
+	failed += same("deadline flush", got, n, "late\n");
+	_printf("last\n");
+	failed += CHECK(_printf_buffered(0) == 200, "_printf_buffered off");
+	stdout_back(saved);
+	n = grab(fd, got, sizeof(got));
+	return (failed + same("_printf_buffered(0)", got, n, "last\n"));
+}
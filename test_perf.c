@@ -0,0 +1,102 @@
+#include "test_compare.h"
+
+#define ROUNDS 5
+#define CALLS 20000
+
+/**
+ * struct bench_s - one throughput case
+ * @fmt: format, reads an int, an unsigned, a string and a long in order
+ * @limit: highest allowed ratio of _cprintf to glibc ns/op, about 1.25
+ * times what the unoptimized make test build measures
+ */
+typedef struct bench_s
+{
+	const char *fmt;
+	double limit;
+} bench_t;
+
+static const bench_t bench[] = {
+	{"%d\n", 4.0},
+	{"%d %x\n", 4.3},
+	{"%d %u %s\n", 5.4},
+	{"id=%d hex=%#x name=%-12s|\n", 5.0},
+	{"%+08d %o %.3s %ld\n", 4.8},
+	{"%5d %-5u %10.2s %lx\n", 5.1},
+	{"plain text without any directive at all\n", 1.15},
+	{NULL, 0}
+};
+
+/**
+ * perf_case - times one round of CALLS calls of a format
+ * @who: 0 for fprintf on libc, 1 for _cprintf on ctx
+ * @fmt: format
+ * @libc: stream on /dev/null
+ * @ctx: context on /dev/null
+ *
+ * Return: ns per call
+ */
+
+double perf_case(int who, const char *fmt, FILE *libc, printf_ctx_t *ctx)
+{
+	struct timespec t0, t1;
+	double ns;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < CALLS; i++)
+		if (who == 0)
+			fprintf(libc, fmt, i - 12345, i + 0xbeefU, "widget",
+					i + 1234567890L);
+		else
+			_cprintf(ctx, fmt, i - 12345, i + 0xbeefU, "widget",
+					i + 1234567890L);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+	return (ns / CALLS);
+}
+
+/**
+ * perf_run - compares the ns/op of _cprintf and glibc on the bench
+ * formats, best of ROUNDS rounds taken in turns so both see the same
+ * load; TEST_PERF_SLACK scales every limit, 0 turns the check off
+ *
+ * Return: 0, 1 if a case regressed past its limit
+ */
+
+int perf_run(void)
+{
+	static char vbuf[1 << 16];
+	const char *env = getenv("TEST_PERF_SLACK");
+	double slack = env ? atof(env) : 1.0, ours = 0, libc = 0, limit, ns;
+	FILE *null = fopen("/dev/null", "w");
+	printf_ctx_t *ctx = NULL;
+	int k, r, failed = 0;
+
+	if (null != NULL)
+		ctx = _ctx_open(fileno(null), 1 << 16);
+	if (ctx == NULL)
+		return (1);
+	setvbuf(null, vbuf, _IOFBF, sizeof(vbuf));
+	printf("%-42s %9s %9s %6s %6s\n", "perf", "ns/op", "glibc", "ratio",
+			"limit");
+	for (k = 0; bench[k].fmt != NULL; k++)
+	{
+		for (r = 0; r < ROUNDS; r++)
+		{
+			ns = perf_case(1, bench[k].fmt, null, ctx);
+			ours = (r == 0 || ns < ours) ? ns : ours;
+			ns = perf_case(0, bench[k].fmt, null, ctx);
+			libc = (r == 0 || ns < libc) ? ns : libc;
+		}
+		limit = bench[k].limit * slack;
+		printf("%-42.*s %9.1f %9.1f %6.2f %6.2f%s\n",
+				(int)strcspn(bench[k].fmt, "\n"), bench[k].fmt,
+				ours, libc, ours / libc, limit,
+				(slack > 0 && ours > libc * limit) ?
+				"  REGRESSED" : "");
+		failed |= (slack > 0 && ours > libc * limit);
+	}
+	_ctx_close(ctx);
+	fclose(null);
+	return (failed);
+}
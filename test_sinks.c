@@ -0,0 +1,132 @@
+#include "test_compare.h"
+#include <fcntl.h>
+
+/**
+ * string_check - a string sink starting small grows to hold every call
+ * and counts its growth as FLUSH_GROW, not as full flushes
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int string_check(int fd)
+{
+	printf_ctx_t *ctx = _ctx_sink(_sink_string(16));
+	char want[512], *p = want;
+	int i, failed;
+
+	(void)fd;
+	if (ctx == NULL)
+		return (CHECK(0, "sink open"));
+	for (i = 0; i < 100; i++)
+	{
+		_cprintf(ctx, "%d,", i);
+		p += sprintf(p, "%d,", i);
+	}
+	failed = CHECK(_close(ctx->output) == 0, "string sink close");
+	failed += same("string sink", ctx->output->start,
+			strlen(ctx->output->start), want);
+	failed += CHECK(ctx->output->flushed[FLUSH_GROW] > 0 &&
+			ctx->output->flushed[FLUSH_FULL] == 0,
+			"string sink growth counted as FLUSH_GROW");
+	_ctx_close(ctx);
+	return (failed);
+}
+
+/**
+ * memory_check - a memory sink keeps what fits, NUL terminated, and
+ * still returns the full length like snprintf
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int memory_check(int fd)
+{
+	char mem[16];
+	printf_ctx_t *ctx = _ctx_sink(_sink_memory(mem, sizeof(mem)));
+	int n, failed;
+
+	(void)fd;
+	if (ctx == NULL)
+		return (CHECK(0, "sink open"));
+	n = _cprintf(ctx, "%s-%d", "hello, world", 12345);
+	n += _cprintf(ctx, "%s", "dropped");
+	failed = CHECK(_ctx_close(ctx) == 0, "memory sink close");
+	failed += CHECK(n == 25, "memory sink counts dropped bytes");
+	return (failed + same("memory sink", mem, strlen(mem),
+				"hello, world-12"));
+}
+
+/**
+ * mmap_check - an mmap sink mapped smaller than its output remaps and
+ * leaves the file exactly as long as what was written
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int mmap_check(int fd)
+{
+	char path[] = "/tmp/test_compare_XXXXXX", want[512], got[512];
+	printf_ctx_t *ctx;
+	int i, failed, map = mkstemp(path);
+	long int n;
+
+	(void)fd;
+	if (map < 0)
+		return (CHECK(0, "mkstemp"));
+	ctx = _ctx_sink(_sink_mmap(path, 64));
+	for (i = 0, *want = '\0'; ctx != NULL && i < 100; i++)
+	{
+		_cprintf(ctx, "%x;", i);
+		sprintf(want + strlen(want), "%x;", i);
+	}
+	failed = CHECK(ctx != NULL && _ctx_close(ctx) == 0, "mmap sink close");
+	n = pread(map, got, sizeof(got), 0);
+	close(map);
+	unlink(path);
+	return (failed + same("mmap sink", got, n, want));
+}
+
+/**
+ * callback_check - a callback sink hands over each formatted call once
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int callback_check(int fd)
+{
+	char got[64];
+	printf_ctx_t *ctx = _ctx_sink(_sink_callback(cb_append, got, 0));
+	int failed;
+
+	(void)fd;
+	if (ctx == NULL)
+		return (CHECK(0, "sink open"));
+	*got = '\0';
+	_cprintf(ctx, "a=%d ", 1);
+	_cprintf(ctx, "b=%s ", "two");
+	_cprintf(ctx, "%%");
+	failed = CHECK(_ctx_close(ctx) == 0, "callback sink close");
+	return (failed + same("callback sink", got, strlen(got),
+				"<a=1 ><b=two ><%>"));
+}
+
+/**
+ * cb_append - callback of callback_check, appends a chunk in <>
+ * @arg: NUL terminated string to append to
+ * @buf: chunk
+ * @n: no of bytes
+ *
+ * Return: n
+ */
+
+int cb_append(void *arg, const char *buf, unsigned int n)
+{
+	char *s = arg;
+
+	sprintf(s + strlen(s), "<%.*s>", (int)n, buf);
+	return (n);
+}
@@ -0,0 +1,133 @@
+#include "test_compare.h"
+
+#define LOG_THREADS 4
+#define LOG_RECORDS 200
+
+/* filler of the log records, the longest is longer than the staging */
+static const char pad[] = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+	"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+	"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+
+/**
+ * maplog_check - threads append records to one log through staging
+ * buffers shorter than some records; every record must land whole
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int maplog_check(int fd)
+{
+	char path[] = "/tmp/test_compare_XXXXXX";
+	pthread_t thread[LOG_THREADS];
+	maplog_t *log;
+	void *ret;
+	int i, failed = 0;
+
+	(void)fd;
+	i = mkstemp(path);
+	if (i < 0)
+		return (CHECK(0, "mkstemp"));
+	close(i);
+	log = _maplog_open(path, 1UL << 20, 4096, 8192, 0);
+	if (log == NULL)
+		return (CHECK(0, "maplog open"));
+	for (i = 0; i < LOG_THREADS; i++)
+		pthread_create(&thread[i], NULL, maplog_writer, log);
+	for (i = 0; i < LOG_THREADS; i++)
+	{
+		pthread_join(thread[i], &ret);
+		failed += CHECK(ret == NULL, "maplog writer close");
+	}
+	failed += CHECK(_maplog_close(log) == 0, "maplog close");
+	failed += maplog_verify(path);
+	unlink(path);
+	return (failed);
+}
+
+/**
+ * maplog_writer - appends LOG_RECORDS records tagged with its thread
+ * @log: log
+ *
+ * Return: 0, or non-NULL if the context failed
+ */
+
+void *maplog_writer(void *log)
+{
+	static int tags;
+	printf_ctx_t *ctx = _ctx_sink(_sink_maplog(log, 64));
+	int i, tag = 'a' + __atomic_fetch_add(&tags, 1, __ATOMIC_RELAXED);
+
+	if (ctx == NULL)
+		return (log);
+	for (i = 0; i < LOG_RECORDS; i++)
+		_cprintf(ctx, "%c%04d %.*s|\n", tag, i,
+				(int)(i * 7 % (sizeof(pad) - 1)), pad);
+	return (_ctx_close(ctx) == 0 ? NULL : log);
+}
+
+/**
+ * maplog_verify - reads the log back: each line one whole record, the
+ * records of a thread in the order it wrote them
+ * @path: log file
+ *
+ * Return: no of checks that failed
+ */
+
+int maplog_verify(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	int next[LOG_THREADS] = {0}, tag, i, n, lines = 0, bad = 0;
+	char line[256];
+
+	if (f == NULL)
+		return (CHECK(0, "maplog reopen"));
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		tag = line[0] - 'a';
+		i = atoi(line + 1);
+		n = strspn(line + 6, "x");
+		if (tag < 0 || tag >= LOG_THREADS || i != next[tag]++ ||
+				n != (int)(i * 7 % (sizeof(pad) - 1)) ||
+				strcmp(line + 6 + n, "|\n") != 0)
+			bad++;
+		lines++;
+	}
+	fclose(f);
+	return (CHECK(bad == 0 && lines == LOG_THREADS * LOG_RECORDS,
+				"maplog records whole and in order"));
+}
+
+/**
+ * asprintf_check - strings that fit the stack buffer and strings that
+ * are formatted twice, from malloc and from an arena
+ * @fd: unused
+ *
+ * Return: no of checks that failed
+ */
+
+int asprintf_check(int fd)
+{
+	arena_t *arena = _arena(0);
+	char *s = NULL, want[1024];
+	int n, failed;
+
+	(void)fd;
+	if (arena == NULL)
+		return (CHECK(0, "arena"));
+	n = _asprintf(&s, "%s=%d", "key", 42);
+	failed = same("_asprintf", s, n, "key=42");
+	free(s);
+	sprintf(want, "%700d|%s", -7, "tail");
+	n = _asprintf(&s, "%700d|%s", -7, "tail");
+	failed += same("_asprintf past the stack buffer", s, n, want);
+	free(s);
+	n = _asprintf_alloc(&arena->alloc, &s, "%s-%u", "arena", 7U);
+	failed += same("_asprintf_alloc", s, n, "arena-7");
+	n = _asprintf_alloc(&arena->alloc, &s, "%700d|%s", -7, "tail");
+	failed += same("_asprintf_alloc past the stack buffer", s, n, want);
+	n = _asprintf(&s, NULL);
+	failed += CHECK(n == -1 && s == NULL, "_asprintf NULL format");
+	_arena_free(arena);
+	return (failed);
+}
@@ -0,0 +1,149 @@
+#include "main.h"
+
+unsigned int _vchar(buffer_t *output, char c, unsigned char flag, int width);
+unsigned int _vstr(buffer_t *output, const char *str, unsigned char flag,
+		int width, int precision);
+unsigned int _vint(buffer_t *output, long int d, unsigned char flag,
+		int width, int precision);
+unsigned int _vuint(buffer_t *output, unsigned long int num, char spec,
+		unsigned char flag, int width, int precision);
+unsigned int _vjson(buffer_t *output, const char *str, char spec,
+		int precision);
+
+/**
+ * _vchar - stores a char with its width (%c)
+ * @output: struct
+ * @c: char
+ * @flag: flag
+ * @width: width
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vchar(buffer_t *output, char c, unsigned char flag, int width)
+{
+	unsigned int ret = 0;
+
+	ret += print_width(output, 1, flag, width);
+	ret += _memcpy(output, &c, 1);
+	ret += neg_width(output, ret, flag, width);
+	return (ret);
+}
+
+/**
+ * _vstr - stores a string with its width and precision (%s)
+ * @output: struct
+ * @str: string, NULL prints (null), or nothing if precision cuts it
+ * @flag: flag
+ * @width: width, counted in the width mode
+ * @precision: prec, max no of bytes stored
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vstr(buffer_t *output, const char *str, unsigned char flag,
+		int width, int precision)
+{
+	unsigned int max, n, ret = 0;
+
+	if (str == NULL)
+		str = (precision == -1 || precision >= 6) ? "(null)" : "";
+	max = (precision == -1) ? UINT_MAX : (unsigned int)precision;
+	if (NEG_FLAG == 0 && width > 0)
+		ret += string_width(output, flag, width, precision,
+				_measure(str, max, width));
+	n = _strput(output, str, max);
+	ret += n;
+	if (NEG_FLAG == 1)
+		ret += neg_width(output, _measure(str, n, width), flag, width);
+	return (ret);
+}
+
+/**
+ * _vint - stores a signed decimal with sign, padding and precision
+ * (%d, %i)
+ * @output: struct
+ * @d: value
+ * @flag: flag
+ * @width: width
+ * @precision: prec
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vint(buffer_t *output, long int d, unsigned char flag,
+		int width, int precision)
+{
+	char digits[64], *sign;
+	unsigned long int num = d;
+	int n;
+
+	if (GROUP_FLAG == 1)
+		return (_vgroup(output, d, 'd', flag, width, precision));
+	num = (d < 0) ? -num : num;
+	n = (num == 0 && precision == 0) ? 0 : (int)_digits(digits, num, 'd');
+	sign = (d < 0) ? "-" : PLUS_FLAG ? "+" : SPACE_FLAG ? " " : "";
+	return (_vnum(output, digits + 64 - n, n, sign, flag, width,
+				precision));
+}
+
+/**
+ * _vuint - stores an unsigned value in the base of its specifier
+ * (%u, %o, %x, %X, %b)
+ * @output: struct
+ * @num: value
+ * @spec: u, o, x, X or b
+ * @flag: flag, # leads x and X with 0x and makes o start with 0
+ * @width: width
+ * @precision: prec
+ *
+ * Return: no.of bytes stored in buffer
+ */
+
+unsigned int _vuint(buffer_t *output, unsigned long int num, char spec,
+		unsigned char flag, int width, int precision)
+{
+	char digits[64], *lead = "";
+	int n;
+
+	if (spec == 'u' && GROUP_FLAG == 1)
+		return (_vgroup(output, num, spec, flag, width, precision));
+	if (spec == 'b')
+		return (_vbin(output, num, flag, width, precision));
+	n = (num == 0 && precision == 0) ? 0 : (int)_digits(digits, num, spec);
+	if (HASH_FLAG == 1 && num != 0 && (spec == 'x' || spec == 'X'))
+		lead = (spec == 'x') ? "0x" : "0X";
+	if (HASH_FLAG == 1 && spec == 'o' && (num != 0 || n == 0) &&
+			precision <= n)
+		lead = "0";
+	return (_vnum(output, digits + 64 - n, n, lead, flag, width,
+				precision));
+}
+
+/**
+ * _vjson - stores a string as json (%j) or as a logfmt value (%J), bare
+ * when it can be and otherwise quoted and escaped like json
+ * @output: struct
+ * @str: string, NULL prints null (%j) or "" (%J)
+ * @spec: j or J
+ * @precision: prec, max no of input bytes
+ *
+ * Return: no of bytes stored
+ */
+
+unsigned int _vjson(buffer_t *output, const char *str, char spec,
+		int precision)
+{
+	unsigned int max, n;
+
+	if (str == NULL)
+		return ((spec == 'j') ? _memcpy(output, "null", 4) :
+				_memcpy(output, "\"\"", 2));
+	max = (precision == -1) ? UINT_MAX : (unsigned int)precision;
+	if (spec == 'j')
+		return (_jstring(output, str, max));
+	n = strnlen(str, max);
+	if (n == 0 || _quote_span(str, n, 0x21, "\"=\\") != n)
+		return (_jstring(output, str, n));
+	return (_memcpy(output, str, n));
+}
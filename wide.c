@@ -0,0 +1,136 @@
+#include "main.h"
+
+unsigned int _utf8(char *dst, unsigned long int cp);
+unsigned int _wchar(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _wstring(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len);
+unsigned int _wmeasure(const wchar_t *str, unsigned int max, int width);
+
+/**
+ * _utf8 - encodes a code point as utf-8
+ * @dst: at least 4 bytes
+ * @cp: code point, surrogates and out of range become U+FFFD
+ *
+ * Return: no of bytes written
+ */
+unsigned int _utf8(char *dst, unsigned long int cp)
+{
+	if (cp < 0x80)
+	{
+		dst[0] = cp;
+		return (1);
+	}
+	if (cp < 0x800)
+	{
+		dst[0] = 0xc0 | (cp >> 6);
+		dst[1] = 0x80 | (cp & 0x3f);
+		return (2);
+	}
+	if (cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff))
+		cp = 0xfffd;
+	if (cp < 0x10000)
+	{
+		dst[0] = 0xe0 | (cp >> 12);
+		dst[1] = 0x80 | ((cp >> 6) & 0x3f);
+		dst[2] = 0x80 | (cp & 0x3f);
+		return (3);
+	}
+	dst[0] = 0xf0 | (cp >> 18);
+	dst[1] = 0x80 | ((cp >> 12) & 0x3f);
+	dst[2] = 0x80 | ((cp >> 6) & 0x3f);
+	dst[3] = 0x80 | (cp & 0x3f);
+	return (4);
+}
+
+/**
+ * _wchar - converts wint_t to utf-8 and stores in buffer (%lc)
+ * @ap: arg
+ * @output: struct
+ * @flag: flag
+ * @width: width, counted in the width mode
+ * @precision: prec
+ * @len: length
+ *
+ * Return: no.of bytes stored in buffer
+ */
+unsigned int _wchar(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	char utf[4];
+	unsigned long int c;
+	unsigned int n, size, ret = 0;
+	int mode = _printf_width_mode(-1);
+
+	(void)precision;
+	(void)len;
+	c = va_arg(ap, wint_t);
+	n = _utf8(utf, c);
+	size = (mode == WIDTH_BYTES) ? n : (mode == WIDTH_POINTS) ? 1 :
+		_ucols(c);
+	ret += string_width(output, flag, width, -1, size);
+	ret += _memcpy(output, utf, n);
+	ret += neg_width(output, size, flag, width);
+	return (ret);
+}
+
+/**
+ * _wstring - converts wide string to utf-8 and stores in buffer (%ls)
+ * @ap: arg
+ * @output: struct
+ * @flag: flag
+ * @width: width, counted in the width mode
+ * @precision: prec, max no of bytes stored
+ * @len: length
+ *
+ * Return: no.of bytes stored in buffer
+ */
+unsigned int _wstring(va_list ap, buffer_t *output, unsigned char flag,
+		int width, int precision, unsigned char len)
+{
+	wchar_t *str;
+	unsigned int max, n, ret = 0;
+
+	(void)len;
+	str = va_arg(ap, wchar_t *);
+	if (str == NULL)
+		return (_vstr(output, NULL, flag, width, precision));
+	max = (precision == -1) ? UINT_MAX : (unsigned int)precision;
+	if (NEG_FLAG == 0 && width > 0)
+		ret += string_width(output, flag, width, -1,
+				_wmeasure(str, max, width));
+	n = _wput(output, str, max);
+	ret += n;
+	if (NEG_FLAG == 1)
+		ret += neg_width(output, _wmeasure(str, n, width), flag, width);
+	return (ret);
+}
+
+/**
+ * _wmeasure - size in the width mode of the utf-8 encoding of a wide
+ * string cut at max bytes, counting stops once width is reached
+ * @str: wide string
+ * @max: cap on the no of utf-8 bytes, ie the precision
+ * @width: width
+ *
+ * Return: size in bytes, code points or columns
+ */
+unsigned int _wmeasure(const wchar_t *str, unsigned int max, int width)
+{
+	char utf[4];
+	unsigned int n, bytes = 0, size = 0, stop = (width > 0) ? width : 0;
+	int mode = _printf_width_mode(-1);
+
+	for (; *str && size < stop; str++)
+	{
+		n = ((unsigned long int)*str < 0x80) ? 1 : _utf8(utf, *str);
+		if (bytes + n > max)
+			break;
+		bytes += n;
+		if (mode == WIDTH_BYTES)
+			size += n;
+		else
+			size += (mode == WIDTH_POINTS) ? 1 : _ucols(*str);
+	}
+	return (size);
+}
@@ -0,0 +1,91 @@
+#include "main.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+unsigned int _wwindow(char *dst, unsigned int n, const wchar_t **str,
+		unsigned int cnt, char *utf, unsigned int *k);
+unsigned int _wput(buffer_t *output, const wchar_t *str, unsigned int max);
+
+/**
+ * _wwindow - encodes wide chars as utf-8 into a reserved window, runs of
+ * 4 ascii wide chars are packed to bytes with SSE2
+ * @dst: window
+ * @n: window size
+ * @str: wide string, left at the first char not encoded
+ * @cnt: no of wide chars to encode
+ * @utf: gets the sequence of the char that did not fit
+ * @k: length of that sequence, 0 if all cnt chars were encoded
+ *
+ * Return: bytes written
+ */
+unsigned int _wwindow(char *dst, unsigned int n, const wchar_t **str,
+		unsigned int cnt, char *utf, unsigned int *k)
+{
+	const wchar_t *s = *str;
+	unsigned int c, j = 0, w = 0;
+#if defined(__SSE2__)
+	__m128i v, m, lo = _mm_set1_epi32(0), hi = _mm_set1_epi32(0x7f);
+	int word;
+#endif
+
+	for (c = 0; c < cnt; c++, s++, j += w, w = 0)
+	{
+#if defined(__SSE2__)
+		if (cnt - c >= 4 && n - j >= 4)
+		{
+			v = _mm_loadu_si128((const __m128i *)s);
+			m = _mm_or_si128(_mm_cmplt_epi32(v, lo),
+					_mm_cmpgt_epi32(v, hi));
+			if (_mm_movemask_epi8(m) == 0)
+			{
+				v = _mm_packus_epi16(_mm_packs_epi32(v, v), v);
+				word = _mm_cvtsi128_si32(v);
+				memcpy(dst + j, &word, 4);
+				c += 3;
+				s += 3;
+				w = 4;
+				continue;
+			}
+		}
+#endif
+		w = _utf8(utf, *s);
+		if (j + w > n)
+			break;
+		memcpy(dst + j, utf, w);
+	}
+	*str = s;
+	*k = w;
+	return (j);
+}
+
+/**
+ * _wput - stores a wide string as utf-8, never splitting a sequence;
+ * each window is bounded with wcsnlen
+ * @output: struct
+ * @str: wide string
+ * @max: cap on the no of bytes, ie the precision
+ *
+ * Return: no of bytes stored
+ */
+unsigned int _wput(buffer_t *output, const wchar_t *str, unsigned int max)
+{
+	char *dst, utf[4];
+	unsigned int i = 0, n, k;
+
+	while (i < max && *str)
+	{
+		n = max - i;
+		dst = _reserve(output, &n);
+		n = _wwindow(dst, n, &str, wcsnlen(str, n), utf, &k);
+		i += _commit(output, n);
+		if (k == 0)
+			continue;
+		if (i + k > max)
+			break;
+		i += _memcpy(output, utf, k);
+		str++;
+	}
+	return (i);
+}